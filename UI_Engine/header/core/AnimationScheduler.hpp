@@ -0,0 +1,170 @@
+#pragma once
+
+#include "utils/Interpolation.hpp"
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// how a value type is split into float channels for tweening
+template <typename T>
+struct AnimationChannels;
+
+template <>
+struct AnimationChannels<float> {
+	static constexpr int Count = 1;
+	static void Pack(const float& value, float* out) { out[0] = value; }
+	static float Unpack(const float* in) { return in[0]; }
+};
+
+template <>
+struct AnimationChannels<sf::Vector2f> {
+	static constexpr int Count = 2;
+	static void Pack(const sf::Vector2f& value, float* out) { out[0] = value.x; out[1] = value.y; }
+	static sf::Vector2f Unpack(const float* in) { return {in[0], in[1]}; }
+};
+
+template <>
+struct AnimationChannels<sf::Color> {
+	static constexpr int Count = 4;
+	static void Pack(const sf::Color& value, float* out) {
+		out[0] = value.r; out[1] = value.g; out[2] = value.b; out[3] = value.a;
+	}
+	// easings overshoot, channels are clamped back into range
+	static sf::Color Unpack(const float* in) {
+		auto channel = [](float v) { return static_cast<sf::Uint8>(std::clamp(v, 0.f, 255.f) + 0.5f); };
+		return {channel(in[0]), channel(in[1]), channel(in[2]), channel(in[3])};
+	}
+};
+
+// refers to a tween started on an AnimationScheduler, goes stale once it finishes or is cancelled
+struct AnimationHandle {
+	std::uint32_t index = 0;
+	std::uint32_t generation = 0;	// 0 is never handed out
+
+	explicit operator bool() const { return generation != 0; }
+	bool operator==(const AnimationHandle& other) const { return index == other.index && generation == other.generation; }
+};
+
+/*
+	runs the GUI's tweens. the clock is sampled once per frame in Tick (and published as FrameClock::now
+	for Interpolated), then only the tweens that are running get advanced: they sit packed in
+	structure-of-arrays form, so a frame eases and lerps all of them in a few EasingBatch passes
+	before handing each its value. a finished one gets its exact end value and is swapped out.
+	the clock can be replaced, e.g. with a counter a test steps by hand.
+*/
+class AnimationScheduler {
+public:
+	using Clock = std::function<double()>;	// seconds, any origin
+
+	AnimationScheduler();
+	AnimationScheduler(const AnimationScheduler&) = delete;
+	AnimationScheduler& operator=(const AnimationScheduler&) = delete;
+
+	// set it before starting anything, running tweens keep start times from the old clock
+	void setClock(Clock newClock);
+
+	// samples the clock and advances every running tween, returns how many ran.
+	// tweens started from a callback get their first value on the next tick
+	int Tick();
+	// time of the last Tick, what new tweens start from
+	double Now() const { return now; }
+
+	// tweens from -> to over duration seconds starting at this frame, apply gets each frame's value
+	template <typename T>
+	AnimationHandle Animate(const T& from, const T& to, float duration, std::function<void(const T&)> apply,
+							InterpolationType easing = InterpolationType::easeInOutElastic);
+
+	// tweens target from its current value to `to`, writing each frame's value straight into it (no callback
+	// to call, the cheap way to run thousands). target must outlive the tween, see setOwner
+	template <typename T>
+	AnimationHandle AnimateTo(T& target, const T& to, float duration, InterpolationType easing = InterpolationType::easeInOutElastic);
+
+	// called once after the last apply, not when the tween is cancelled
+	void setOnFinished(AnimationHandle handle, std::function<void()> onFinished);
+	// the tween is dropped silently once owner is gone, so apply never touches a destroyed widget
+	void setOwner(AnimationHandle handle, std::weak_ptr<const void> owner);
+
+	// stops the tween where it is
+	void Cancel(AnimationHandle handle);
+	bool IsRunning(AnimationHandle handle) const { return Find(handle) != nullptr; }
+	std::size_t ActiveCount() const { return tweens.size() - cancelled; }
+
+private:
+	static constexpr int MaxChannels = 4;
+	static constexpr std::uint32_t NoTween = 0xffffffffu;
+
+	// what Tick doesn't touch in its batch passes, the timing and values live in the arrays below
+	struct Tween {
+		std::uint32_t slot = 0;
+		bool cancelled = false;
+		bool owned = false;
+		std::weak_ptr<const void> owner;
+		void* target = nullptr;	// AnimateTo: store writes the value here instead of calling apply
+		void (*store)(void* target, const float* value) = nullptr;
+		std::function<void(const float*)> apply;
+		std::function<void()> onFinished;
+	};
+	struct Slot {
+		std::uint32_t generation = 1;
+		std::uint32_t tween = NoTween;	// index into tweens while it runs
+	};
+
+	AnimationHandle Start(Tween&& tween, const float* from, const float* to, float duration, InterpolationType easing);
+	Tween* Find(AnimationHandle handle);
+	const Tween* Find(AnimationHandle handle) const;
+	// swaps the tween out of the packed array and frees its handle
+	void Retire(std::uint32_t index);
+
+	Clock clock;
+	double now = 0.0;
+	std::vector<Tween> tweens;	// running, packed; index i in every array below is tweens[i]
+	std::vector<double> starts;
+	std::vector<float> invDurations;	// 0 = finish on the first tick
+	std::vector<InterpolationType> easings;
+	std::vector<float> from[MaxChannels];	// unused channels stay 0
+	std::vector<float> to[MaxChannels];
+	std::vector<Slot> slots;
+	std::vector<std::uint32_t> freeSlots;
+	bool ticking = false;
+	std::size_t cancelled = 0;	// tweens cancelled mid-tick, retired when the tick is over
+
+	// per-tick scratch: progress (eased in place), the tweens of one easing gathered, the values
+	std::vector<float> progress;
+	std::vector<float> gathered;
+	std::vector<std::uint32_t> gatheredIndex;
+	std::vector<float> values[MaxChannels];
+};
+
+template <typename T>
+AnimationHandle AnimationScheduler::Animate(const T& from, const T& to, float duration, std::function<void(const T&)> apply,
+											InterpolationType easing) {
+	using Channels = AnimationChannels<T>;
+	static_assert(Channels::Count <= MaxChannels, "too many channels for a tween");
+
+	float packedFrom[MaxChannels] = {}, packedTo[MaxChannels] = {};
+	Channels::Pack(from, packedFrom);
+	Channels::Pack(to, packedTo);
+
+	Tween tween;
+	tween.apply = [apply = std::move(apply)](const float* value) { if (apply) apply(Channels::Unpack(value)); };
+	return Start(std::move(tween), packedFrom, packedTo, duration, easing);
+}
+
+template <typename T>
+AnimationHandle AnimationScheduler::AnimateTo(T& target, const T& to, float duration, InterpolationType easing) {
+	using Channels = AnimationChannels<T>;
+	static_assert(Channels::Count <= MaxChannels, "too many channels for a tween");
+
+	float packedFrom[MaxChannels] = {}, packedTo[MaxChannels] = {};
+	Channels::Pack(target, packedFrom);
+	Channels::Pack(to, packedTo);
+
+	Tween tween;
+	tween.target = &target;
+	tween.store = [](void* destination, const float* value) { *static_cast<T*>(destination) = Channels::Unpack(value); };
+	return Start(std::move(tween), packedFrom, packedTo, duration, easing);
+}
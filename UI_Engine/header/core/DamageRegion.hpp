@@ -0,0 +1,30 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+/*
+	the screen areas that changed since the last frame. rects are snapped out to whole pixels and
+	merged as they come in whenever they overlap, and past MaxRects the whole region collapses
+	into one bounding rect, so a frame never has to clip and redraw more than a handful of times.
+*/
+class DamageRegion {
+public:
+	static constexpr std::size_t MaxRects = 16;
+
+	void Add(const sf::FloatRect& rect);
+	void Clear() { rects.clear(); }
+	// drops everything outside area (e.g. the target's bounds)
+	void ClipTo(const sf::FloatRect& area);
+
+	bool Empty() const { return rects.empty(); }
+	const std::vector<sf::FloatRect>& Rects() const { return rects; }
+	// summed area of the rects (they don't overlap after merging)
+	float Area() const;
+	bool Intersects(const sf::FloatRect& rect) const;
+
+	static sf::FloatRect Bounding(const sf::FloatRect& a, const sf::FloatRect& b);
+
+private:
+	std::vector<sf::FloatRect> rects;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class UIElement;
+
+/*
+	name -> element lookup for everything attached to a GUI. elements register themselves when
+	they're added to a tree and drop out when they're removed or destroyed, so lookups never walk
+	the tree. ids don't change after construction, so the id string is the key.
+*/
+class ElementIndex {
+public:
+	ElementIndex() = default;
+	ElementIndex(const ElementIndex&) = delete;
+	ElementIndex& operator=(const ElementIndex&) = delete;
+
+	void Add(UIElement* element);
+	void Remove(UIElement* element);
+
+	// the first element registered under name (ids aren't forced to be unique), nullptr if none
+	UIElement* Find(const std::string& name) const;
+
+	std::size_t Size() const { return count; }
+
+private:
+	std::unordered_map<std::string, std::vector<UIElement*>> byName;
+	std::size_t count = 0;
+};
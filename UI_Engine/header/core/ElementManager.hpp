@@ -15,9 +15,52 @@
 #include "../widgets/UITextField.hpp"
 #include "../widgets/UISlider.hpp"
 #include "core/UIEvent.hpp"
+#include "renderer/SFMLRenderBackend.hpp"
+#include "core/GUIContext.hpp"
+#include "core/DamageRegion.hpp"
+#include "utils/WidgetArena.hpp"
+#include <cstdint>
+#include <type_traits>
+
+// per-frame counters, measured from one draw() to the next
+struct FrameStats {
+	int textRebuilds = 0;	// text runs whose glyph quads had to be regenerated
+	int measureHits = 0;	// text measurements served by TextMeasureCache
+	int measureMisses = 0;	// and the ones it had to lay out
+	int layoutVisited = 0;	// elements reached by the layout pass in Update()
+	int layoutRecomputed = 0;	// of those, elements that were actually resized or moved
+	int ticked = 0;	// elements whose UpdateSelf ran in Update()
+	int animated = 0;	// tweens advanced in Update()
+	int damageRects = 0;	// rects the changed areas were merged into
+	float pixelsRedrawn = 0.f;	// area painted: the damage for drawDamaged(), everything the roots cover for draw()
+	int elementsDrawn = 0;	// DrawSelf calls
+	int layerHits = 0;	// cached roots composited from their layer as is
+	int layerMisses = 0;	// cached roots whose layer had to be redrawn
+};
+
+// how GUI allocates the widgets it creates
+enum class AllocationMode {
+	Shared,	// one make_shared per widget
+	Pooled	// widgets (and their control blocks) come out of a WidgetArena owned by the GUI
+};
+
+// generational reference to a GUI-owned widget, goes stale (Get returns nullptr) once the widget is destroyed
+template <typename T>
+struct WidgetHandle {
+	std::uint32_t index = 0;
+	std::uint32_t generation = 0;	// 0 is never handed out, so a default handle is always stale
+
+	explicit operator bool() const { return generation != 0; }
+	bool operator==(const WidgetHandle& other) const { return index == other.index && generation == other.generation; }
+};
 
 class GUI {
 public:
+	explicit GUI(AllocationMode mode = AllocationMode::Shared);
+	~GUI();
+	GUI(const GUI&) = delete;
+	GUI& operator=(const GUI&) = delete;
+
     std::shared_ptr<UIRoot> CreateRoot();
     std::shared_ptr<UIList> CreateList();
 
@@ -26,15 +69,61 @@ public:
     std::shared_ptr<UITextField> CreateTextField();
     std::shared_ptr<UISlider> CreateSlider();
 
+	// widget owned by the GUI itself: it stays alive (in or out of a tree) until Destroy or DestroyAll
+	template <typename T>
+	WidgetHandle<T> Create(const std::string& name = "");
+	template <typename T>
+	T* Get(WidgetHandle<T> handle) const;
+	template <typename T>
+	std::shared_ptr<T> Share(WidgetHandle<T> handle) const;
+	// takes the widget out of its tree and drops the GUI's reference, every handle to it goes stale
+	template <typename T>
+	void Destroy(WidgetHandle<T> handle) { DestroySlot(handle.index, handle.generation); }
+	// drops every GUI-owned widget at once
+	void DestroyAll();
+
+	AllocationMode GetAllocationMode() const { return allocationMode; }
+
+	// O(1), served from an index kept up to date by AddChild/RemoveChild
     std::shared_ptr<UIElement> GetElementByName(const std::string& name);
 
+	// removes the named element wherever it is, along with its subtree
     void RemoveElementByName(const std::string& name);
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default);
+	// draw a frame into any backend (e.g. RecordingRenderBackend on headless machines)
+	void draw(RenderBackend& backend, sf::RenderStates states = sf::RenderStates::Default);
+
+	// partial redraw into a target that keeps its pixels between frames (e.g. a RenderTexture cleared once
+	// to background): only the damaged areas are cleared to background and repainted, clipped to them
+	void drawDamaged(sf::RenderTarget& target, const sf::Color& background, sf::RenderStates states = sf::RenderStates::Default);
+	// area is what's visible of the GUI (usually the target's bounds), damage outside it is dropped
+	void drawDamaged(RenderBackend& backend, const sf::Color& background, const sf::FloatRect& area,
+					 sf::RenderStates states = sf::RenderStates::Default);
+	// screen areas that changed, as collected by the last draw()/drawDamaged()
+	const DamageRegion& GetDamage() const { return damage; }
+
+	// draw calls / vertices submitted by the last draw(target)
+	const RenderStats& GetRenderStats() const { return renderer.GetStats(); }
+	const FrameStats& GetFrameStats() const { return frameStats; }
 
     void HandleEvent(const UIEvent& event);
+	// topmost element under a screen position, nullptr if none
+	UIElement* HitTest(const sf::Vector2f& point);
+
+	// keyboard and text events only go to the focused element (and bubble to its ancestors)
+	FocusManager& GetFocus() { return context.focus; }
 
 	void Update(const float dt);
+
+	// event-driven hosts: draw only when NeedsRedraw(), and when idle wait at most
+	// TimeUntilNextChange() seconds for input (0 = something animates every frame, infinity = block)
+	bool NeedsRedraw() const { return context.paintDirty; }
+	float TimeUntilNextChange() const { return context.animations.ActiveCount() > 0 ? 0.f : context.ticks.NextDue(); }
+
+	// tweens advanced once per Update, off one clock sample (replace the clock for deterministic runs)
+	AnimationScheduler& GetAnimations() { return context.animations; }
+
 	void ProcessEvent(const sf::Event& event);
 
 	void RefreshLayout() {
@@ -44,7 +133,9 @@ public:
 	}
 
 	void AddRoot(std::shared_ptr<UIRoot> root) {
+		root->AttachTo(nullptr, &context);
 		UIRoots.push_back(std::move(root));
+		UIElement::TreeVersion++;
 	}
 
 	const std::vector<std::shared_ptr<UIRoot>>& GetRoots() const {
@@ -53,7 +144,84 @@ public:
 
 
 private:
+	// allocates a widget according to the allocation mode
+	template <typename T, typename... Args>
+	std::shared_ptr<T> Make(Args&&... args);
+
+	struct WidgetSlot {
+		std::shared_ptr<UIElement> element;
+		std::uint32_t generation = 1;
+	};
+	std::uint32_t AcquireSlot(std::shared_ptr<UIElement> element);
+	void DestroySlot(std::uint32_t index, std::uint32_t generation);
+	void Detach(UIElement* element);
+	// turns the paint queue into this frame's damage
+	void CollectDamage();
+	void FinishFrameStats();
+
+	AllocationMode allocationMode;
+	std::shared_ptr<WidgetArena> arena;
+	std::vector<WidgetSlot> slots;
+	std::vector<std::uint32_t> freeSlots;
+
+	GUIContext context;	// name index, tick list, animations and focus, declared before the roots so it outlives them
     std::vector<std::shared_ptr<UIRoot>> UIRoots;
+	SFMLRenderBackend renderer;
+
+	DamageRegion damage;
+	std::vector<sf::FloatRect> damageScratch;
+
+	FrameStats frameStats;
+	int lastTextRebuilds = 0;
+	std::uint64_t lastMeasureHits = 0;
+	std::uint64_t lastMeasureMisses = 0;
+	int lastDrawVisits = 0;
+	int lastLayerHits = 0;
+	int lastLayerMisses = 0;
+	int lastLayoutVisits = 0;
+	int lastLayoutRecomputes = 0;
 	
-    std::shared_ptr<UIElement> FindElementRecursive(const std::shared_ptr<UIElement>& element, const std::string& name);
+	// pointer events only go to the element under the cursor plus the ones that need to see it leave
+	std::weak_ptr<UIElement> hovered;	// under the cursor after the last move
+	std::weak_ptr<UIElement> captured;	// took the last MouseDown, gets moves and the MouseUp until release
+	std::weak_ptr<UIElement> lastPressed;	// previous MouseDown target, sees the next MouseDown (e.g. to drop focus)
+	void DispatchPointer(const UIEvent& event);
+	void DispatchWheel(const UIEvent& event);
+
+	int focusChainVersion = -1;	// TreeVersion the focus chain was collected at
+	void RefreshFocusChain();
 };
+
+template <typename T, typename... Args>
+std::shared_ptr<T> GUI::Make(Args&&... args) {
+	if (allocationMode == AllocationMode::Pooled) {
+		return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+	}
+	return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+template <typename T>
+WidgetHandle<T> GUI::Create(const std::string& name) {
+	static_assert(std::is_base_of_v<UIElement, T>, "GUI::Create makes UI elements");
+	std::shared_ptr<T> widget = name.empty() ? Make<T>() : Make<T>(name);
+	if constexpr (std::is_base_of_v<UIRoot, T>) AddRoot(widget);
+
+	WidgetHandle<T> handle;
+	handle.index = AcquireSlot(widget);
+	handle.generation = slots[handle.index].generation;
+	return handle;
+}
+
+template <typename T>
+T* GUI::Get(WidgetHandle<T> handle) const {
+	if (handle.index >= slots.size()) return nullptr;
+	const WidgetSlot& slot = slots[handle.index];
+	if (slot.generation != handle.generation || !slot.element) return nullptr;
+	return static_cast<T*>(slot.element.get());
+}
+
+template <typename T>
+std::shared_ptr<T> GUI::Share(WidgetHandle<T> handle) const {
+	T* widget = Get(handle);
+	return widget ? std::static_pointer_cast<T>(slots[handle.index].element) : nullptr;
+}
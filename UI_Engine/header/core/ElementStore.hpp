@@ -0,0 +1,79 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+#include "core/HitGrid.hpp"
+
+class UIElement;
+
+/*
+	structure-of-arrays copy of the layout and hit-test state below one root, in pre-order
+	(which is also paint order). the slot order is rebuilt only when the structure changes,
+	layout writes positions/sizes straight into the arrays as it places elements, and
+	pointer queries run on these arrays without touching the widget objects.
+	nested roots sit in this store as one element, their children live in their own store.
+*/
+class ElementStore {
+public:
+	enum Flags : std::uint8_t {
+		Enabled = 1 << 0,
+		Visible = 1 << 1,
+		Container = 1 << 2,
+		Boundary = 1 << 3	// a nested root: its children are in its own store, it renders them itself
+	};
+
+	ElementStore() = default;
+	ElementStore(const ElementStore&) = delete;
+	ElementStore& operator=(const ElementStore&) = delete;
+
+	// children of owner go in here, the owner itself doesn't
+	void SetOwner(UIElement* root) { owner = root; MarkDirty(); }
+
+	void MarkDirty() { dirty = true; }
+	bool IsDirty() const { return dirty; }
+	// re-collects the slots if the structure changed since the last call
+	void Ensure();
+
+	// keep one element's slot current (no-op while a rebuild is pending, the rebuild reads everything)
+	void SyncBounds(const UIElement& element);
+	void SyncFlags(const UIElement& element);
+	void SyncOffset(const UIElement& element);
+
+	// where slot i is drawn relative to its layout position: its own visual offset plus its ancestors' in here
+	sf::Vector2f VisualOffset(std::int32_t slot) const;
+	// some element is away from its layout position (a layout transition is running)
+	bool HasOffsets() const { return moving > 0; }
+
+	// slot of the topmost enabled, visible element whose hit bounds contain point (no disabled or hidden
+	// ancestors), -1 if none. elements are hit where they're drawn, while any is offset that's a scan
+	// instead of a grid lookup
+	std::int32_t TopmostAt(const sf::Vector2f& point);
+
+	std::size_t Size() const { return elements.size(); }
+
+	// whether an enabled/visible flag pattern hides the element's whole subtree
+	static bool SkipsRender(std::uint8_t f) { return !(f & Visible) || ((f & Container) && !(f & Enabled)); }
+
+	// pre-order arrays, slot i describes elements[i]
+	std::vector<UIElement*> elements;
+	std::vector<sf::Vector2f> positions;	// owner-local, same as e_position
+	std::vector<sf::Vector2f> sizes;
+	std::vector<sf::FloatRect> drawBounds;	// getDrawBounds, what partial redraws cull against
+	std::vector<std::int32_t> parents;		// slot of the parent, -1 for the owner's direct children
+	std::vector<std::uint32_t> subtreeEnds;	// one past the last slot of the element's subtree
+	std::vector<std::uint8_t> flags;
+	std::vector<sf::Vector2f> offsets;	// each element's own e_visualOffset
+
+private:
+	void Rebuild();
+	bool Reachable(std::int32_t slot) const;
+	void Collect(UIElement* element, std::int32_t parentSlot);
+	static std::uint8_t FlagsOf(const UIElement& element);
+
+	UIElement* owner = nullptr;
+	HitGrid grid;
+	bool dirty = true;
+	std::size_t moving = 0;	// slots with a nonzero offset
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "core/UIEvent.hpp"
+
+class UIElement;
+
+/*
+	keyboard focus for a GUI: key and text events go to the focused element and then bubble up
+	through its ancestors, nobody else sees them. Tab order is the tree's pre-order over the
+	focusable elements, collected once per structural change so stepping through it is O(1).
+*/
+class FocusManager {
+public:
+	// nullptr clears the focus. the element is told even if it already had focus, so it can re-take it
+	void SetFocus(UIElement* element);
+	UIElement* GetFocused() const { return focused.lock().get(); }
+
+	// move along the focus chain (wrapping), skipping disabled elements
+	bool FocusNext();
+	bool FocusPrevious();
+
+	// deliver a keyboard/text event to the focused element and its ancestors, false if nothing has focus
+	bool Dispatch(const UIEvent& event);
+
+	// collects the focus chain from these roots, in order
+	void Rebuild(const std::vector<UIElement*>& roots);
+	std::size_t ChainSize() const { return chain.size(); }
+
+private:
+	bool Step(int direction);
+	void Collect(UIElement* element);
+
+	std::weak_ptr<UIElement> focused;
+	std::vector<std::weak_ptr<UIElement>> chain;
+	std::unordered_map<const UIElement*, std::size_t> chainIndex;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "core/AnimationScheduler.hpp"
+#include "core/ElementIndex.hpp"
+#include "core/FocusManager.hpp"
+#include "core/TickList.hpp"
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+// per-GUI state that elements reach through the tree they're attached to
+struct GUIContext {
+	ElementIndex names;
+	TickList ticks;
+	AnimationScheduler animations;
+	FocusManager focus;	// widgets give their own focus up through it
+	bool paintDirty = true;	// set by markPaintDirty, cleared when the GUI draws
+	std::vector<UIElement*> paintQueue;	// elements marked since the last draw (null once they leave), their old and new bounds are damage
+	std::vector<sf::FloatRect> damage;	// areas left behind by elements that were removed since the last draw
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/*
+	uniform grid over element bounds, keyed by the elements' slots in an ElementStore.
+	entries are updated one at a time as layout moves things, a lookup touches one cell
+	(plus the few elements too big to bucket) instead of walking the tree.
+*/
+class HitGrid {
+public:
+	explicit HitGrid(float cellSize = 128.f) : cellSize(cellSize) {}
+
+	HitGrid(const HitGrid&) = delete;
+	HitGrid& operator=(const HitGrid&) = delete;
+
+	void Update(std::uint32_t slot, const sf::FloatRect& bounds);
+	void Clear();
+
+	// every slot whose bounds contain point, in no particular order
+	const std::vector<std::uint32_t>& Query(const sf::Vector2f& point);
+
+private:
+	// anything covering more cells than this goes to a list that every query checks
+	static constexpr int MaxCellsPerElement = 64;
+
+	struct Entry {
+		sf::FloatRect bounds;
+		sf::IntRect cells;	// left/top = first cell, width/height = last cell (inclusive)
+		bool oversized = false;
+		bool present = false;
+	};
+
+	sf::IntRect CellsFor(const sf::FloatRect& bounds) const;
+	static std::int64_t Key(int x, int y) { return (static_cast<std::int64_t>(x) << 32) ^ static_cast<std::uint32_t>(y); }
+	void Unlink(std::uint32_t slot, const Entry& entry);
+
+	float cellSize;
+	std::vector<Entry> entries;	// indexed by slot
+	std::unordered_map<std::int64_t, std::vector<std::uint32_t>> cells;
+	std::vector<std::uint32_t> oversized;
+	std::vector<std::uint32_t> results;
+};
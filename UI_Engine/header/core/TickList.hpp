@@ -0,0 +1,36 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+class UIElement;
+
+/*
+	the elements that actually need a per-frame Update: an onTick callback, a running animation,
+	a blinking caret. elements add and remove themselves as that changes (UIElement::RefreshTick),
+	so a frame costs as much as the active widgets, not the whole tree.
+*/
+class TickList {
+public:
+	TickList() = default;
+	TickList(const TickList&) = delete;
+	TickList& operator=(const TickList&) = delete;
+
+	void Set(UIElement* element, bool active);
+	bool Contains(const UIElement* element) const { return index.count(element) != 0; }
+
+	// UpdateSelf on every registered element that isn't disabled (itself or through an ancestor),
+	// returns how many ran. the list may change while this runs
+	int Tick(const float dt);
+
+	// smallest NextTickIn of the registered elements, infinity if nothing is registered
+	float NextDue() const;
+
+	std::size_t Size() const { return index.size(); }
+
+private:
+	std::vector<UIElement*> elements;	// removed entries are nulled while ticking, compacted after
+	std::unordered_map<const UIElement*, std::size_t> index;
+	bool ticking = false;
+	bool hasHoles = false;
+};
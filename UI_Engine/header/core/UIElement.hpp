@@ -1,12 +1,16 @@
 #pragma once
 
 #include <vector>
+#include <limits>
 #include <memory>
 #include <string>
 #include <SFML/Graphics.hpp>
 #include "utils/assetManager.hpp"
 #include "utils/Interpolation.hpp"
 #include "core/UIEvent.hpp"
+#include "core/ElementStore.hpp"
+#include "core/GUIContext.hpp"
+#include "renderer/RenderBackend.hpp"
 
 // Layout enums
 enum class LayoutAnchor { TopLeft, TopRight, BottomLeft, BottomRight, Center };
@@ -16,10 +20,13 @@ enum class SizeType { Absolute, FitContent, FillParent, Percent };
 class UIElement : public std::enable_shared_from_this<UIElement> {
 public:
     inline static int ElementCount = 0;
+	inline static int TreeVersion = 0;	// bumped whenever an element is added somewhere, for caches built from the tree
 
 	sf::Vector2f e_position = {0, 0};
     sf::Vector2f e_offset   = {0, 0};
-    sf::Vector2f e_size     = {150, 50};
+	sf::Vector2f e_visualOffset = {0, 0};	// drawn and hit this far from e_position (a layout transition), see SetVisualOffset
+    sf::Vector2f e_size     = {150, 50};	// computed by the layout pass
+    sf::Vector2f e_requestedSize = {150, 50};	// what setSize asked for (pixels, or % for SizeType::Percent)
     sf::Color e_fillcolor = sf::Color::White;
     std::string id;
 
@@ -37,26 +44,108 @@ public:
     float borderThickness = 2.f;
     sf::Color borderColor = sf::Color::Black;
 
-	bool layoutDirty = true;
+	bool layoutDirty = true;		// this element's own layout inputs changed
+	bool childLayoutDirty = false;	// something below it needs layout
+
+	// layout work done since start, GUI turns these into per-frame counts
+	inline static int LayoutVisits = 0;		// elements reached by a layout pass
+	inline static int LayoutRecomputes = 0;	// elements whose size or position was actually recomputed
+	inline static int DrawVisits = 0;		// DrawSelf calls
+
+	// outlines and the focus glow reach a few pixels past the element's box
+	static constexpr float PaintMargin = 8.f;
 
     UIElement(const std::string& id);
 
 	sf::Vector2f getSize(){return e_size;}
+	// e_position is relative to the nearest enclosing root, this is where the element is on screen (visual offsets included)
+	sf::Vector2f getGlobalPosition() const;
+
+	// offset applied to the children's coordinates (drawing and mouse events), roots use their own position
+	virtual sf::Vector2f ChildTranslation() const { return {0, 0}; }
 
     virtual UIElement* AddChild(std::shared_ptr<UIElement> child) { return nullptr; }
-    virtual void CalculateLayout() = 0;
-    virtual void Update(const float dt) = 0;
 
-    virtual void Render(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) = 0;	// for drawing children
-    virtual void DrawSelf(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) = 0;	// for drawing itself
+	// lays out this element (and whatever below it is dirty) inside its parent's content area
+	void CalculateLayout();
+	bool NeedsLayout() const { return layoutDirty || childLayoutDirty; }
+
+	// two-pass layout: Measure sizes the element for the area it's given, PlaceAt positions it and
+	// arranges its children. both return early when their inputs match the last pass and nothing is dirty
+	sf::Vector2f Measure(const sf::Vector2f& available);
+	void PlaceAt(const sf::Vector2f& position);
+	// where the layoutType puts this element inside a content box
+	sf::Vector2f ResolvePosition(const sf::Vector2f& origin, const sf::Vector2f& area) const;
+
+	// layout moves of this element and its children glide to the new place over seconds instead of jumping
+	// (0 = off). layout still runs once per change: only a visual offset is animated, easing back to 0
+	void SetLayoutTransition(float seconds, InterpolationType easing = InterpolationType::cssEaseInOut);
+	// whether the children's layout moves animate
+	virtual bool AnimatesChildren() const { return transitionDuration > 0.f; }
+	// moves where the element (and its subtree) is drawn and hit without touching its layout
+	void SetVisualOffset(const sf::Vector2f& offset);
+	// states moved by the element's visual offset, what its parent draws it with
+	sf::RenderStates WithVisualOffset(sf::RenderStates states) const {
+		if (e_visualOffset != sf::Vector2f(0, 0)) states.transform.translate(e_visualOffset);
+		return states;
+	}
+
+    virtual void Update(const float dt) {}	// a leaf's own per-frame work, reached through UpdateSelf
+	virtual void UpdateSelf(const float dt) {}	// run once per frame by the GUI's tick list while WantsTick()
+
+    virtual void Render(RenderBackend& renderer, sf::RenderStates states = sf::RenderStates::Default) = 0;	// for drawing children
+    virtual void DrawSelf(RenderBackend& renderer, sf::RenderStates states = sf::RenderStates::Default) = 0;	// for drawing itself
     virtual void HandleEvent(const UIEvent& event) {};	// default empty event handler but may be overridden by derived classes
-    virtual ~UIElement() {}
+	virtual void HandleSelfEvent(const UIEvent& event) {};	// an event aimed at this element only, HandleEvent routes through the subtree
+    virtual ~UIElement();
+
+	// whether the element can hold keyboard focus at all (see FocusManager)
+	virtual bool IsFocusable() const { return false; }
+	virtual void OnFocusChanged(bool hasFocus) {}
+	// whether the element scrolls on MouseWheel, the wheel goes to the innermost one under the cursor
+	virtual bool WantsWheel() const { return false; }
+
+	// area that takes pointer events, in the same space as e_position. HitTest gets points in that space
+	// too, whoever calls it has taken the element's visual offset out already
+	virtual sf::FloatRect getHitBounds() const { return {e_position, e_size}; }
+	// area DrawSelf covers, same space as e_position: the hit area plus whatever is drawn beside it
+	virtual sf::FloatRect getDrawBounds() const { return getHitBounds(); }
+	// screen area the element draws into (draw bounds plus the paint margin), what a paint change damages
+	virtual sf::FloatRect getPaintBounds() const;
+	// appends the area painted last frame and the area painted now, called by the GUI once per marked element
+	void CollectDamage(std::vector<sf::FloatRect>& out);
+	// element under point (same space as e_position), nullptr if it misses or is disabled
+	virtual UIElement* HitTest(const sf::Vector2f& point) { return enabled && visible && getHitBounds().contains(point) ? this : nullptr; }
+
+	// registers this element (and its subtree) with the store of the root it now belongs to and
+	// the GUI's name index and tick list, nullptrs take it out of all of them
+	virtual void AttachTo(ElementStore* store, GUIContext* context);
+	// store the children go into, roots start a new one
+	virtual ElementStore* ChildStore() { return store; }
+
+	// true while the element needs UpdateSelf every frame, call RefreshTick when the answer may have changed
+	virtual bool WantsTick() const { return false; }
+	// seconds until UpdateSelf next changes something on its own, 0 = every frame, infinity = only after input
+	virtual float NextTickIn() const { return 0.f; }
+	void RefreshTick();
+
+	// prefer these over writing enabled/visible directly, they keep the root's ElementStore in sync
+	void SetEnabled(bool en);
+	void SetVisible(bool vis);
+
+	// something this element draws changed, the GUI needs a new frame (and a redraw of the area).
+	// contentChanged = false when only the element's position changed, its own cached layer stays valid
+	void markPaintDirty(bool contentChanged = true);
+	// drops a cached rendering of this element's subtree (UIRoot::setCached), called for every paint change below
+	virtual void InvalidateLayer() {}
 
 	void markLayoutDirty() {
 		layoutDirty = true;
+		markPaintDirty();
 
-		if (auto parentPtr = parent.lock()) {
-			parentPtr->markLayoutDirty();
+		// ancestors only need to look down, they re-measure themselves only if a child's size changes
+		for (auto parentPtr = parent.lock(); parentPtr && !parentPtr->childLayoutDirty; parentPtr = parentPtr->parent.lock()) {
+			parentPtr->childLayoutDirty = true;
 		}
 	}
 
@@ -65,7 +154,47 @@ protected:
         return std::to_string(UIElement::ElementCount);
 	}
 
-	Interpolated<sf::Vector2f> interpolated_position;
+	// size for SizeType::FitContent, children must be measured here if the content depends on them
+	virtual sf::Vector2f MeasureContent(const sf::Vector2f& available) { return e_requestedSize; }
+	// positions children once this element has its final position and size
+	virtual void ArrangeChildren() {}
+
+	// moves the element outside a layout pass, for moves nothing else depends on. a layout transition applies as usual
+	void MoveTo(const sf::Vector2f& position);
+	bool snapNextMove = false;	// the next move jumps even with a layout transition, e.g. while the user drags the element
+
+	// bounds (in states' space, without the paint margin) lie entirely outside the renderer's clip, drawing them is wasted
+	static bool OutsideClip(const RenderBackend& renderer, const sf::RenderStates& states, const sf::FloatRect& bounds) {
+		if (!renderer.HasClip()) return false;
+		sf::FloatRect padded(bounds.left - PaintMargin, bounds.top - PaintMargin, bounds.width + PaintMargin * 2.f, bounds.height + PaintMargin * 2.f);
+		return !renderer.GetClip().intersects(states.transform.transformRect(padded));
+	}
+
+	ElementStore* store = nullptr;	// owned by the enclosing root, kept current by PlaceAt
+	GUIContext* context = nullptr;	// owned by the GUI the tree is in
+
+private:
+	friend class ElementStore;
+	std::int32_t storeSlot = -1;	// our slot in store, valid while the store isn't dirty
+
+	// drops out of context's index, tick list and paint queue, leaving the painted area as damage
+	void LeaveContext();
+	// takes the new position, animating the move relative to the parent if a layout transition applies
+	void Relocate(const sf::Vector2f& position);
+	sf::Vector2f ParentOrigin() const;
+	void StopTransition();
+
+	float transitionDuration = 0.f;
+	InterpolationType transitionEasing = InterpolationType::cssEaseInOut;
+	AnimationHandle transitionTween;	// eases e_visualOffset back to 0
+	sf::Vector2f placedRelative = {0, 0};	// position relative to ParentOrigin at the last move
+	sf::FloatRect paintedBounds;	// what CollectDamage reported last, empty if never drawn
+	std::int32_t paintQueueSlot = -1;	// our entry in context->paintQueue, -1 if not queued
+
+	// inputs of the last layout pass, a clean element given the same inputs has nothing to do
+	bool hasLayout = false;
+	sf::Vector2f measuredAvailable = {-1, -1};
+	sf::Vector2f arrangedSize = {0, 0};
 };
 
 // Leaf type: cannot have children, only draws itself
@@ -75,12 +204,15 @@ public:
     // Leaves cannot have children
     UIElement* AddChild(std::shared_ptr<UIElement> child) override { return nullptr; }
 
-    void Render(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) override {
-		
-        DrawSelf(target, states);
+    void Render(RenderBackend& renderer, sf::RenderStates states = sf::RenderStates::Default) override {
+		DrawVisits++;
+        DrawSelf(renderer, states);
     }
 	
     void HandleEvent(const UIEvent& event) override {};
+	// nothing to route through, the widget's own handler is all there is
+	void HandleSelfEvent(const UIEvent& event) override { HandleEvent(event); }
+	void UpdateSelf(const float dt) override { Update(dt); }
 };
 
 // Container type: can have children and manages layout
@@ -91,17 +223,17 @@ public:
 
     UIContainer(const std::string& id);
     UIElement* AddChild(std::shared_ptr<UIElement> child) override;
-    void Render(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) override;
+	// like AddChild, but the child goes before children[index] (at the end if index is past it)
+	UIElement* InsertChild(std::size_t index, std::shared_ptr<UIElement> child);
+    void Render(RenderBackend& renderer, sf::RenderStates states = sf::RenderStates::Default) override;
     void HandleEvent(const UIEvent& event) override;
+	void AttachTo(ElementStore* store, GUIContext* context) override;
+	// detaches child and returns it (nullptr if it isn't one of ours), the whole subtree leaves the GUI's indexes
+	std::shared_ptr<UIElement> RemoveChild(UIElement* child);
 
-	void markChildrenDirty(){
-		layoutDirty = true;
-		for (auto& child : children) {
-			if (auto leaf = dynamic_cast<UILeaf*>(child.get())) {
-				leaf->layoutDirty = true;
-			} else if (auto container = dynamic_cast<UIContainer*>(child.get())) {
-				container->markChildrenDirty();
-			}
-		}
-	}
+protected:
+	// extent of the children (from the top-left corner) plus padding
+	sf::Vector2f MeasureContent(const sf::Vector2f& available) override;
+	// measures every child against the content area and places it by its layoutType
+	void ArrangeChildren() override;
 };
\ No newline at end of file
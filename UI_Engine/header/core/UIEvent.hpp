@@ -10,7 +10,8 @@ enum class UIEventType {
     Leave,
     KeyDown,
     KeyUp,
-	TextEntered
+	TextEntered,
+	MouseWheel
 };
 
 struct UIEvent {
@@ -19,6 +20,7 @@ struct UIEvent {
     int mouseButton = 0; // 0=left, 1=right.
     int key = 0;         // Key code for keyboard events
     char textChar = 0;   // Character for text input events
+	float wheelDelta = 0.f;	// MouseWheel notches, positive scrolls up
 
 	bool ctrl  = false;
     bool shift = false;
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "renderer/GlyphRasterizer.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/*
+	one texture for every glyph the GUI draws, whatever the font or size, plus a white block
+	that solid fills sample from. with rects and text on the same texture a whole frame can
+	batch into one draw call (sf::Font keeps a separate page per character size).
+	glyphs come from GlyphRasterizer and are packed into shelves; the texture grows in height
+	until it hits the memory budget, after that the least recently used shelf is emptied.
+	eviction moves glyphs around, so it bumps the generation and text built before re-lays itself out.
+	quads already queued against the old texels have to be drawn first, renderers that queue them
+	register an eviction listener for that.
+*/
+class GlyphAtlas {
+public:
+	static GlyphAtlas& get();
+
+	GlyphAtlas(const GlyphAtlas&) = delete;
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+	// bytes of texture the atlas may use (rgba8); a budget that changes the page width or is smaller
+	// than what's in use drops every glyph
+	void setBudget(std::size_t bytes);
+	std::size_t getBudget() const { return budget; }
+
+	// fonts the rasterizer can't open (see GlyphRasterizer) aren't handled here, use sf::Font's pages for them
+	bool HasFont(const sf::Font& font) { return rasterizer.HasFont(font); }
+
+	// same metrics sf::Font::getGlyph reports, textureRect is in the atlas. nullptr if the font isn't handled
+	const sf::Glyph* GetGlyph(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize);
+	float GetKerning(const sf::Font& font, sf::Uint32 first, sf::Uint32 second, unsigned int characterSize) {
+		return rasterizer.GetKerning(font, first, second, characterSize);
+	}
+	float GetLineSpacing(const sf::Font& font, unsigned int characterSize) { return rasterizer.GetLineSpacing(font, characterSize); }
+
+	// uploads whatever was packed since the last call, needs a GL context
+	const sf::Texture& GetTexture();
+	// texture coordinate inside the white block
+	static sf::Vector2f WhiteTexel() { return {WhiteSize / 2.f, WhiteSize / 2.f}; }
+
+	// bumped whenever glyphs were evicted, texture rects handed out before may be stale
+	std::uint32_t GetGeneration() const { return generation; }
+
+	// called right before glyphs are evicted or dropped, while their texels are still intact
+	void AddEvictionListener(const void* owner, std::function<void()> listener);
+	void RemoveEvictionListener(const void* owner);
+
+	std::size_t GlyphCount() const { return glyphs.size(); }
+	std::size_t Evictions() const { return evictions; }
+	sf::Vector2u GetSize() const { return {width, height}; }
+
+	// drops every glyph
+	void Clear();
+
+private:
+	GlyphAtlas();
+
+	static constexpr unsigned int WhiteSize = 4;	// white block in the top-left corner, wide enough for smooth sampling
+	static constexpr unsigned int Padding = 2;	// around each glyph, like sf::Font
+	static constexpr unsigned int InitialHeight = 256;
+
+	struct Key {
+		const sf::Font* font;
+		sf::Uint32 codePoint;
+		unsigned int characterSize;
+		bool operator==(const Key& other) const {
+			return font == other.font && codePoint == other.codePoint && characterSize == other.characterSize;
+		}
+	};
+	struct KeyHash {
+		std::size_t operator()(const Key& key) const {
+			std::size_t h = std::hash<const void*>()(key.font);
+			h ^= (static_cast<std::size_t>(key.codePoint) << 8 | key.characterSize) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+			return h;
+		}
+	};
+	struct Entry {
+		sf::Glyph glyph;
+		std::uint32_t shelf = 0;
+	};
+	struct Shelf {
+		unsigned int y = 0;
+		unsigned int height = 0;
+		unsigned int cursor = 0;	// next free x
+		std::uint64_t lastUsed = 0;
+		std::vector<Key> keys;	// glyphs living here, dropped together on eviction
+	};
+
+	// top-left of a free w x h area, evicting or growing as needed; false if it can never fit
+	bool Allocate(unsigned int w, unsigned int h, sf::Vector2u& position, std::uint32_t& shelfIndex);
+	bool Grow();
+	void Evict(Shelf& shelf);
+	void NotifyEviction();
+	void Reset(unsigned int newWidth);
+	void MarkDirty(const sf::IntRect& rect);
+
+	GlyphRasterizer rasterizer;
+	std::unordered_map<Key, Entry, KeyHash> glyphs;
+	std::vector<Shelf> shelves;
+	unsigned int nextShelfY = WhiteSize;
+
+	std::size_t budget = 4u << 20;	// a 1024x1024 page
+	unsigned int width = 0;
+	unsigned int height = 0;
+	std::vector<std::uint8_t> pixels;	// rgba8, white with the coverage in alpha (like sf::Font)
+
+	sf::Texture texture;
+	bool textureStale = true;	// size changed, the whole image has to go up
+	sf::IntRect dirty;	// area packed since the last upload, empty if none
+	std::vector<std::uint8_t> uploadScratch;
+
+	std::uint32_t generation = 0;
+	std::vector<std::pair<const void*, std::function<void()>>> evictionListeners;
+	std::uint64_t tick = 0;
+	std::size_t evictions = 0;
+};
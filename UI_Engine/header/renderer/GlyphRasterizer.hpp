@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SFML/Graphics/Font.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// a glyph rendered on the cpu: 8-bit coverage plus the same metrics sf::Glyph reports
+struct RasterGlyph {
+	float advance = 0.f;
+	int lsbDelta = 0;
+	int rsbDelta = 0;
+	int left = 0;		// bitmap offset from the pen position, top is negative above the baseline
+	int top = 0;
+	unsigned int width = 0;
+	unsigned int height = 0;
+	std::vector<std::uint8_t> coverage;	// width * height, row-major
+};
+
+/*
+	renders glyphs straight from FreeType without going through sf::Font's page textures,
+	so it works where no GL context can be created. uses the same load flags and size
+	handling as sf::Font so advances, kerning and bitmaps match what SFML would draw.
+	faces are keyed by the sf::Font they stand in for; fonts loaded through AssetManager
+	are found automatically, anything else needs LoadFont().
+*/
+class GlyphRasterizer {
+public:
+	GlyphRasterizer();
+	~GlyphRasterizer();
+
+	GlyphRasterizer(const GlyphRasterizer&) = delete;
+	GlyphRasterizer& operator=(const GlyphRasterizer&) = delete;
+
+	bool LoadFont(const sf::Font& font, const std::string& filename);
+	bool HasFont(const sf::Font& font);
+
+	// nullptr if the font couldn't be resolved
+	const RasterGlyph* GetGlyph(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize);
+	float GetKerning(const sf::Font& font, sf::Uint32 first, sf::Uint32 second, unsigned int characterSize);
+	float GetLineSpacing(const sf::Font& font, unsigned int characterSize);
+
+	// drops the rendered bitmaps, faces stay open
+	void ClearGlyphs();
+
+private:
+	struct Face {
+		void* face = nullptr;	// FT_Face, kept opaque like sf::Font does
+		std::unordered_map<std::uint64_t, RasterGlyph> glyphs;
+	};
+
+	Face* Resolve(const sf::Font& font);
+	bool SetSize(Face& face, unsigned int characterSize);
+
+	void* library = nullptr;	// FT_Library
+	std::unordered_map<const sf::Font*, Face> faces;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "renderer/RenderBackend.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+enum class RenderCommandType {
+	Rect,
+	Triangle,
+	Text,
+	PushClip,
+	PopClip,
+	BeginLayer,	// rect = (0, 0, layer size), what follows up to EndLayer went into the layer
+	EndLayer,
+	DrawLayer	// rect = where the layer was composited
+};
+
+// one recorded primitive, already in target space
+struct RenderCommand {
+	RenderCommandType type = RenderCommandType::Rect;
+
+	sf::FloatRect rect;					// rect bounds, clip rect, or text origin (left/top)
+	sf::Vector2f points[3];				// triangle corners
+	sf::Color color;
+	sf::Color outlineColor;
+	float outlineThickness = 0.f;
+
+	const sf::Font* font = nullptr;
+	unsigned int characterSize = 0;
+	std::uint32_t textOffset = 0;		// slice of the recorder's flat text buffer
+	std::uint32_t textLength = 0;
+
+	bool operator==(const RenderCommand& other) const;
+	bool operator!=(const RenderCommand& other) const { return !(*this == other); }
+};
+
+/*
+	headless backend: captures a frame as a flat command buffer instead of drawing it,
+	so whole frames can be counted, benchmarked and diffed on machines without a GPU.
+	text is stored as utf-32 in one shared buffer; no glyphs are ever loaded.
+*/
+class RecordingRenderBackend : public RenderBackend {
+public:
+	void Begin() override;
+
+	void FillRect(const sf::FloatRect& rect, const sf::Color& fill,
+				  float outlineThickness = 0.f, const sf::Color& outline = sf::Color::Transparent,
+				  const sf::RenderStates& states = sf::RenderStates::Default) override;
+	void FillTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c,
+					  const sf::Color& color, const sf::RenderStates& states = sf::RenderStates::Default) override;
+	void DrawText(const TextRun& text, const sf::RenderStates& states = sf::RenderStates::Default) override;
+
+	// layers only exist as sizes here, what was drawn into them is in the command stream
+	bool HasLayer(const void* key) const override { return layers.count(key) != 0; }
+	void DrawLayer(const void* key, const sf::FloatRect& rect, const sf::RenderStates& states = sf::RenderStates::Default) override;
+	void ReleaseLayer(const void* key) override { layers.erase(key); }
+
+	const std::vector<RenderCommand>& GetCommands() const { return commands; }
+	std::u32string_view GetText(const RenderCommand& command) const {
+		return std::u32string_view(textBuffer.data() + command.textOffset, command.textLength);
+	}
+
+	// index of the first command that differs from other's frame, or -1 if both frames match
+	long long FirstDifference(const RecordingRenderBackend& other) const;
+	// stable hash of the frame, cheap to store per-test as a golden value
+	std::uint64_t Hash() const;
+
+protected:
+	void ClipChanged() override;
+	bool OnBeginLayer(const void* key, const sf::Vector2u& size) override;
+	void OnEndLayer() override;
+
+private:
+	std::vector<RenderCommand> commands;
+	std::unordered_map<const void*, sf::Vector2u> layers;
+	std::u32string textBuffer;
+	std::size_t clipDepth = 0;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "renderer/TextRun.hpp"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// per-frame counters, reset by Begin()
+struct RenderStats {
+	int primitives = 0;	// rects, triangles and text runs submitted by widgets
+	int batches    = 0;
+	int drawCalls  = 0;
+	int vertices   = 0;
+};
+
+/*
+	what UIElement::Render / DrawSelf draw into. a backend receives a frame of primitives
+	between Begin() and End(); SFMLRenderBackend batches them onto a RenderTarget,
+	RecordingRenderBackend just stores them so frames can be measured/diffed without a GPU.
+*/
+class RenderBackend {
+public:
+	virtual ~RenderBackend() = default;
+
+	virtual void Begin() { stats = RenderStats{}; clipStack.clear(); }
+	virtual void End() {}
+
+	virtual void FillRect(const sf::FloatRect& rect, const sf::Color& fill,
+						  float outlineThickness = 0.f, const sf::Color& outline = sf::Color::Transparent,
+						  const sf::RenderStates& states = sf::RenderStates::Default) = 0;
+	virtual void FillTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c,
+							  const sf::Color& color, const sf::RenderStates& states = sf::RenderStates::Default) = 0;
+	virtual void DrawText(const TextRun& text, const sf::RenderStates& states = sf::RenderStates::Default) = 0;
+
+	// clip rects nest: the active clip is the intersection of everything pushed, in target space
+	void PushClip(const sf::FloatRect& rect, const sf::RenderStates& states = sf::RenderStates::Default) {
+		sf::FloatRect clip = states.transform.transformRect(rect);
+		if (!clipStack.empty() && !clipStack.back().intersects(clip, clip)) {
+			clip = sf::FloatRect(clip.left, clip.top, 0.f, 0.f);
+		}
+		clipStack.push_back(clip);
+		ClipChanged();
+	}
+	void PopClip() {
+		if (clipStack.empty()) return;
+		clipStack.pop_back();
+		ClipChanged();
+	}
+	bool HasClip() const { return !clipStack.empty(); }
+	std::size_t ClipDepth() const { return clipStack.size(); }
+	const sf::FloatRect& GetClip() const { return clipStack.back(); }
+
+	/*
+		offscreen layers (see UIRoot::setCached). primitives drawn between BeginLayer and EndLayer go
+		into the layer named key instead of the frame, unclipped, with (0,0) at the layer's corner.
+		layers outlive the frame so DrawLayer can composite one again later as a single quad.
+		backends without layers return false from BeginLayer and the caller draws directly instead.
+	*/
+	bool BeginLayer(const void* key, const sf::Vector2u& size) {
+		if (!OnBeginLayer(key, size)) return false;
+		savedClips.push_back(std::move(clipStack));
+		clipStack.clear();
+		return true;
+	}
+	void EndLayer() {
+		OnEndLayer();
+		clipStack = std::move(savedClips.back());
+		savedClips.pop_back();
+	}
+	virtual bool HasLayer(const void* /*key*/) const { return false; }
+	virtual void DrawLayer(const void* /*key*/, const sf::FloatRect& /*rect*/, const sf::RenderStates& /*states*/ = sf::RenderStates::Default) {}
+	virtual void ReleaseLayer(const void* /*key*/) {}
+
+	const RenderStats& GetStats() const { return stats; }
+
+protected:
+	virtual void ClipChanged() {}
+	virtual bool OnBeginLayer(const void* /*key*/, const sf::Vector2u& /*size*/) { return false; }
+	virtual void OnEndLayer() {}
+
+	RenderStats stats;
+
+private:
+	std::vector<sf::FloatRect> clipStack;
+	std::vector<std::vector<sf::FloatRect>> savedClips;	// the frame's clips while a layer is being drawn
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "renderer/RenderBackend.hpp"
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/*
+	collects a whole frame of solid quads and glyph quads into a few vertex arrays
+	grouped by texture, then submits them to the target in as few draw calls as painter's
+	order allows. a primitive may join an earlier batch with the same texture (and clip)
+	as long as it doesn't overlap anything queued after that batch, so overlapping widgets
+	still draw in order. solid fills sample the white block of the GlyphAtlas, so they share
+	a texture with atlas text and the two interleave without breaking the batch.
+*/
+class SFMLRenderBackend : public RenderBackend {
+public:
+	SFMLRenderBackend();
+	~SFMLRenderBackend();
+	SFMLRenderBackend(const SFMLRenderBackend&) = delete;
+	SFMLRenderBackend& operator=(const SFMLRenderBackend&) = delete;
+
+	// states are applied at flush time; their transform should be identity since
+	// per-primitive transforms are baked into the vertices
+	void SetTarget(sf::RenderTarget* renderTarget, const sf::RenderStates& states = sf::RenderStates::Default) {
+		target = renderTarget;
+		targetStates = states;
+	}
+
+	void Begin() override;
+	void End() override;
+
+	void FillRect(const sf::FloatRect& rect, const sf::Color& fill,
+				  float outlineThickness = 0.f, const sf::Color& outline = sf::Color::Transparent,
+				  const sf::RenderStates& states = sf::RenderStates::Default) override;
+	void FillTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c,
+					  const sf::Color& color, const sf::RenderStates& states = sf::RenderStates::Default) override;
+	void DrawText(const TextRun& text, const sf::RenderStates& states = sf::RenderStates::Default) override;
+
+	// layers are RenderTextures kept until released; drawing one flushes what's queued so far
+	bool HasLayer(const void* key) const override { return layers.count(key) != 0; }
+	void DrawLayer(const void* key, const sf::FloatRect& rect, const sf::RenderStates& states = sf::RenderStates::Default) override;
+	void ReleaseLayer(const void* key) override { layers.erase(key); }
+
+protected:
+	bool OnBeginLayer(const void* key, const sf::Vector2u& size) override;
+	void OnEndLayer() override;
+
+private:
+	struct Batch {
+		const sf::Texture* texture = nullptr;
+		bool premultiplied = false;	// a composited layer, its colour already carries the alpha
+		bool clipped = false;
+		sf::FloatRect clip;
+		sf::VertexArray vertices{sf::Triangles};
+		sf::FloatRect bounds;
+		std::vector<sf::FloatRect> items;	// bounds of every primitive, for overlap tests
+	};
+
+	// how many batches back a primitive may look for a texture match
+	static constexpr std::size_t MaxLookback = 8;
+
+	Batch& BatchFor(const sf::Texture* texture, const sf::FloatRect& bounds);
+	void AddQuad(std::vector<sf::Vertex>& out, const sf::Transform& transform, const sf::FloatRect& rect,
+				 const sf::Color& color, const sf::FloatRect& uv = sf::FloatRect());
+	void Submit(const sf::Texture* texture, const std::vector<sf::Vertex>& vertices);
+	// draws the queued batches to target and empties the queue
+	void Flush();
+
+	sf::RenderTarget* target = nullptr;
+	sf::RenderStates targetStates;
+
+	std::vector<Batch> batches;	// kept across frames so the vertex storage is reused
+	std::size_t batchCount = 0;
+	std::vector<sf::Vertex> scratch;
+
+	std::unordered_map<const void*, std::unique_ptr<sf::RenderTexture>> layers;
+	// targets (and their states) interrupted by the layers being drawn, innermost last
+	std::vector<std::pair<sf::RenderTarget*, sf::RenderStates>> targetStack;
+	bool submittingLayer = false;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "renderer/RenderBackend.hpp"
+#include "renderer/GlyphRasterizer.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+/*
+	cpu rasterizer: draws the frame into an RGBA8 buffer, no GL context needed.
+	rects and outlines go through (SSE2 when available) span fills, triangles are scan
+	converted, and text is composited from FreeType glyph bitmaps. coverage follows sfml's
+	pixel-center rule and blending matches sf::BlendAlpha, so frames line up with what the
+	SFML backend puts on screen (minus texture filtering).
+	only translation/scale transforms are supported; rotated primitives use their bounding box.
+*/
+class SoftwareRenderBackend : public RenderBackend {
+public:
+	SoftwareRenderBackend(unsigned int width = 0, unsigned int height = 0) { Resize(width, height); }
+
+	void Resize(unsigned int width, unsigned int height);
+	void SetClearColor(const sf::Color& color) { clearColor = color; }
+
+	void Begin() override;
+
+	void FillRect(const sf::FloatRect& rect, const sf::Color& fill,
+				  float outlineThickness = 0.f, const sf::Color& outline = sf::Color::Transparent,
+				  const sf::RenderStates& states = sf::RenderStates::Default) override;
+	void FillTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c,
+					  const sf::Color& color, const sf::RenderStates& states = sf::RenderStates::Default) override;
+	void DrawText(const TextRun& text, const sf::RenderStates& states = sf::RenderStates::Default) override;
+
+	unsigned int GetWidth() const { return width; }
+	unsigned int GetHeight() const { return height; }
+	const std::uint8_t* GetPixels() const { return pixels.data(); }
+	sf::Image ToImage() const;
+
+	GlyphRasterizer& GetGlyphs() { return glyphs; }
+
+private:
+	// target ∩ clip in whole pixels, as [left, right) x [top, bottom)
+	sf::IntRect DrawableArea() const;
+	void FillPixelRect(const sf::FloatRect& rect, const sf::Color& color);
+	void BlendSpan(int x0, int x1, int y, const sf::Color& color);
+	void BlendPixel(std::uint8_t* dst, const sf::Color& color, unsigned int alpha);
+
+	unsigned int width = 0;
+	unsigned int height = 0;
+	sf::Color clearColor = sf::Color::Transparent;
+	std::vector<std::uint8_t> pixels;
+	GlyphRasterizer glyphs;
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <array>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// what laying a string out takes, without building any glyph geometry
+struct TextMetrics {
+	float advance = 0.f;	// pen advance of the widest line, trailing spaces included (where a caret after it goes)
+	sf::FloatRect bounds;	// ink bounds, same as TextRun::getLocalBounds / sf::Text::getLocalBounds
+	float lineSpacing = 0.f;	// baseline to baseline
+	float baseline = 0.f;	// first line's baseline, from the top of the text box
+	unsigned int lineCount = 0;
+};
+
+/*
+	measurements shared by every widget, keyed by (font, size, style, string). layout passes,
+	carets and selections ask for the same strings over and over, and each miss used to
+	walk the glyphs through a temporary sf::Text. a miss on plain ascii runs off a per
+	font/size/style table of advances, glyph bounds and kerning pairs filled as they're
+	first needed, so it never goes back to the font for a pair it has seen.
+	glyphs come from the same place TextRun takes them (GlyphAtlas, or the sf::Font for
+	fonts the atlas can't open and for bold), so the numbers match what gets drawn.
+	the least recently used strings are dropped once the cache is full.
+	fonts are identified by address. AssetManager's fonts live until exit and the copies wrapFont
+	makes forget themselves when the last handle goes; a font of your own that you measure
+	directly needs a ForgetFont before it's destroyed.
+*/
+class TextMeasureCache {
+public:
+	static TextMeasureCache& get();
+
+	TextMeasureCache(const TextMeasureCache&) = delete;
+	TextMeasureCache& operator=(const TextMeasureCache&) = delete;
+
+	// text is read the way TextRun reads it. style takes sf::Text::Bold and Italic, underline and
+	// strike-through don't change the box
+	TextMetrics Measure(const sf::Font& font, unsigned int characterSize, std::string_view text,
+						std::uint32_t style = sf::Text::Regular);
+
+	// strings kept at most, shrinking drops the oldest
+	void setCapacity(std::size_t entries);
+	std::size_t getCapacity() const { return capacity; }
+	std::size_t Size() const { return entries.size(); }
+
+	void ForgetFont(const sf::Font& font);
+	void Clear();
+
+	struct Stats {
+		std::uint64_t hits = 0;
+		std::uint64_t misses = 0;
+		std::uint64_t evictions = 0;
+		std::uint64_t asciiMisses = 0;	// misses measured off the ascii tables alone
+		double HitRate() const { return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses); }
+	};
+	const Stats& GetStats() const { return stats; }
+	void ResetStats() { stats = Stats(); }
+
+private:
+	TextMeasureCache() = default;
+
+	static constexpr std::uint32_t AsciiCount = 128;
+
+	// one font at one size and style
+	struct FontKey {
+		const sf::Font* font;
+		unsigned int characterSize;
+		std::uint32_t style;
+		bool operator==(const FontKey& other) const {
+			return font == other.font && characterSize == other.characterSize && style == other.style;
+		}
+	};
+	struct FontKeyHash {
+		std::size_t operator()(const FontKey& key) const {
+			std::size_t h = std::hash<const void*>()(key.font);
+			return h ^ (static_cast<std::size_t>(key.characterSize) * 0x9e3779b97f4a7c15ull) ^ (static_cast<std::size_t>(key.style) << 48);
+		}
+	};
+	// ascii glyphs and pairs (64k of kerning), filled lazily: a NaN pair hasn't been looked up yet
+	struct FontTable {
+		bool useAtlas = false;
+		float lineSpacing = 0.f;
+		std::array<bool, AsciiCount> known{};
+		std::array<float, AsciiCount> advances{};
+		std::array<sf::FloatRect, AsciiCount> glyphBounds{};
+		std::array<float, AsciiCount * AsciiCount> kerning;
+	};
+
+	struct Entry {
+		FontKey font;
+		std::size_t hash;
+		std::string text;
+		TextMetrics metrics;
+	};
+	// refers to an entry's text (or the string being looked up), so lookups don't copy it
+	struct EntryKey {
+		FontKey font;
+		std::size_t hash;
+		std::string_view text;
+		bool operator==(const EntryKey& other) const { return hash == other.hash && font == other.font && text == other.text; }
+	};
+	struct EntryKeyHash {
+		std::size_t operator()(const EntryKey& key) const { return key.hash ^ FontKeyHash()(key.font); }
+	};
+
+	FontTable& TableFor(const FontKey& key);
+	TextMetrics Compute(const FontKey& key, std::string_view text);
+	void Evict();
+
+	std::size_t capacity = 4096;
+	std::list<Entry> entries;	// most recently used first
+	std::unordered_map<EntryKey, std::list<Entry>::iterator, EntryKeyHash> index;
+	std::unordered_map<FontKey, std::unique_ptr<FontTable>, FontKeyHash> tables;
+	Stats stats;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "renderer/TextMeasureCache.hpp"
+#include "utils/assetManager.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+	a piece of text with cached glyph geometry. setters only invalidate when the value
+	actually changes, so widgets can push their state every frame for free; the glyph
+	quads (and the utf-32 conversion) are rebuilt lazily on the next measure or draw.
+	colour changes just recolour the cached quads, moving the run doesn't touch them at all.
+	glyphs come from the shared GlyphAtlas when it can open the font, sf::Font's pages otherwise.
+*/
+class TextRun {
+public:
+	// glyph rebuilds since startup, GUI turns this into a per-frame count
+	inline static int TotalRebuilds = 0;
+
+	TextRun& setString(const std::string& str);
+	TextRun& setFont(const FontHandle& f);
+	TextRun& setCharacterSize(unsigned int size);
+	TextRun& setFillColor(const sf::Color& color);
+	TextRun& setPosition(const sf::Vector2f& pos) { position = pos; return *this; }
+	TextRun& setPosition(float x, float y) { return setPosition({x, y}); }
+
+	const std::string& getString() const { return string; }
+	const sf::Font* getFont() const { return font.get(); }
+	unsigned int getCharacterSize() const { return characterSize; }
+	const sf::Color& getFillColor() const { return fillColor; }
+	const sf::Vector2f& getPosition() const { return position; }
+
+	sf::FloatRect getLocalBounds() const { ensureGeometry(); return bounds; }
+	// the same box and more, from TextMeasureCache: for sizing, when the glyph quads aren't needed yet
+	TextMetrics measure() const;
+
+	// glyph triangles relative to the run's position, textured by getTexture()
+	const std::vector<sf::Vertex>& getVertices() const { ensureGeometry(); return vertices; }
+	const sf::Texture* getTexture() const;
+
+private:
+	void ensureGeometry() const;
+	void buildGeometry() const;
+
+	std::string string;
+	FontHandle font;
+	unsigned int characterSize = 30;
+	sf::Color fillColor = sf::Color::White;
+	sf::Vector2f position;
+
+	mutable std::vector<sf::Vertex> vertices;
+	mutable sf::FloatRect bounds;
+	mutable bool geometryDirty = true;
+	mutable bool colorDirty = false;
+	mutable bool usesAtlas = false;
+	mutable std::uint32_t atlasGeneration = 0;	// rebuilt when the atlas evicted since
+};
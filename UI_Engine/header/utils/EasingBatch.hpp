@@ -0,0 +1,48 @@
+#pragma once
+
+#include "utils/Interpolation.hpp"
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+/*
+	easing and lerping for whole arrays of tweens at once. with SSE2 (every x86-64 build) four values
+	go through per instruction, and the elastic curve uses polynomial exp2/sin approximations
+	(within ~1e-6 of easeInOutElastic) instead of a pow and a sin call per value.
+	other curves, and other targets, go through the scalar Ease (EasingCurves' tables) one value at a time.
+*/
+namespace EasingBatch {
+
+	// t[i] = Ease(type, clamp(t[i], 0, 1)), in place
+	void Ease(InterpolationType type, float* t, std::size_t count);
+
+	// out[i] = from[i] * (1 - t[i]) + to[i] * t[i], exact at t = 0 and t = 1. out may alias from or to
+	void Lerp(const float* from, const float* to, const float* t, float* out, std::size_t count);
+
+	// sf::Vector2f values in structure-of-arrays form, one array per channel
+	struct Vector2Soa {
+		std::vector<float> x, y;
+
+		std::size_t size() const { return x.size(); }
+		void resize(std::size_t count) { x.resize(count); y.resize(count); }
+		void set(std::size_t i, const sf::Vector2f& value) { x[i] = value.x; y[i] = value.y; }
+		sf::Vector2f get(std::size_t i) const { return {x[i], y[i]}; }
+	};
+
+	// sf::Color values in structure-of-arrays form, channels kept as floats so easings can overshoot
+	struct ColorSoa {
+		std::vector<float> r, g, b, a;
+
+		std::size_t size() const { return r.size(); }
+		void resize(std::size_t count) { r.resize(count); g.resize(count); b.resize(count); a.resize(count); }
+		void set(std::size_t i, const sf::Color& value) { r[i] = value.r; g[i] = value.g; b[i] = value.b; a[i] = value.a; }
+		// clamped back into 0..255
+		sf::Color get(std::size_t i) const;
+	};
+
+	// out is resized to match from; from, to and t must have the same length
+	void Lerp(const Vector2Soa& from, const Vector2Soa& to, const float* t, Vector2Soa& out);
+	void Lerp(const ColorSoa& from, const ColorSoa& to, const float* t, ColorSoa& out);
+
+}
@@ -1,10 +1,30 @@
 #pragma once
 
-#include <chrono>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <vector>
 
+// the built-in curves, RegisterCubicBezier and RegisterEasing hand out more values past BuiltinCount
 enum class InterpolationType {
 	Linear,
-	easeInOutElastic
+	easeInOutElastic,
+	easeInQuad,
+	easeOutQuad,
+	easeInOutQuad,
+	easeInCubic,
+	easeOutCubic,
+	easeInOutCubic,
+	easeInOutSine,
+	easeOutBack,
+	easeOutBounce,
+	// the css keywords, cubic-bezier curves
+	cssEase,
+	cssEaseIn,
+	cssEaseOut,
+	cssEaseInOut,
+	BuiltinCount
 };
 
 inline float easeInOutElastic(float x) {
@@ -19,6 +39,77 @@ inline float easeInOutElastic(float x) {
         return 0.5f * std::pow(2.0f, -20.0f * x + 10.0f) * std::sin((20.0f * x - 11.125f) * c5) + 1.0f;
 }
 
+/*
+	every easing curve the GUI knows, each baked into a table of Resolution + 1 samples when it's
+	registered, so easing a value is a table fetch and a lerp whatever the curve costs to compute.
+	the analytic curve stays around (EaseExact) for anything that needs the exact value.
+	registration isn't meant to happen mid-frame: it may move the tables Sample reads.
+*/
+class EasingCurves {
+public:
+	// the smooth curves stay within ~1e-4 of the exact ones, bounce ~2e-3 right at its corners
+	static constexpr int Resolution = 1024;
+	using Table = std::array<float, Resolution + 1>;
+
+	// defined here so Ease inlines all the way down to the table
+	static EasingCurves& get() {
+		static EasingCurves instance;
+		return instance;
+	}
+
+	EasingCurves(const EasingCurves&) = delete;
+	EasingCurves& operator=(const EasingCurves&) = delete;
+
+	// css cubic-bezier(x1, y1, x2, y2), x1 and x2 are clamped to [0, 1]. the same curve twice gives the same type
+	InterpolationType RegisterCubicBezier(float x1, float y1, float x2, float y2);
+	// any curve with f(0) = 0 and f(1) = 1, baked once now
+	InterpolationType RegisterEasing(std::function<float(float)> curve);
+
+	bool IsKnown(InterpolationType type) const { return static_cast<std::size_t>(type) < curves.size(); }
+
+	// table lookup for t in [0, 1] (clamped), unknown types ease linearly
+	float Sample(InterpolationType type, float t) const {
+		std::size_t index = static_cast<std::size_t>(type);
+		if (index >= tables.size()) return t;
+		const Table& table = tables[index];
+
+		float x = (t <= 0.f ? 0.f : t >= 1.f ? 1.f : t) * Resolution;
+		int i = static_cast<int>(x);
+		if (i > Resolution - 1) i = Resolution - 1;
+		float f = x - i;
+		return table[i] * (1.f - f) + table[i + 1] * f;
+	}
+	// the curve itself, computed on every call
+	float EaseExact(InterpolationType type, float t) const;
+
+private:
+	EasingCurves();
+
+	struct CubicBezier { float x1, y1, x2, y2; };
+	struct Curve {
+		std::function<float(float)> exact;
+		bool bezier = false;
+		CubicBezier points{};
+	};
+
+	InterpolationType Add(Curve curve);
+
+	std::vector<Curve> curves;
+	std::vector<Table> tables;	// tables[i] is curves[i] baked
+};
+
+// eased progress for t in [0, 1]
+inline float Ease(InterpolationType type, float t) {
+	if (type == InterpolationType::Linear) return t;
+	return EasingCurves::get().Sample(type, t);
+}
+
+// the time animations see during a frame, in seconds. AnimationScheduler::Tick samples its clock once
+// per frame and stores it here, so every read within a frame agrees and none of them hit the OS clock
+struct FrameClock {
+	inline static float now = 0.f;
+};
+
 template<typename T>
 struct Interpolated{
 	T start{};
@@ -33,18 +124,26 @@ struct Interpolated{
 
 	[[nodiscard]]
 	static float GetCurrentTime() {
-		return std::chrono::duration<float>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		return FrameClock::now;
+	}
+
+	// raw progress, 1 and above once the animation is over
+	[[nodiscard]]
+	float GetProgress() const {
+		return (GetCurrentTime() - startTime) * speed;
 	}
 
 	[[nodiscard]]
 	float GetElapsedTime() const {
-		float t = (GetCurrentTime() - startTime) * speed;
-		switch(InterpolationType){
-			case InterpolationType::Linear:
-				return t;
-			case InterpolationType::easeInOutElastic:
-				return easeInOutElastic(t);
-		}
+		float t = GetProgress();
+		if (t <= 0.0f) return 0.0f;
+		if (t >= 1.0f) return 1.0f;
+		return Ease(InterpolationType, t);
+	}
+
+	[[nodiscard]]
+	bool isFinished() const {
+		return GetProgress() >= 1.0f;
 	}
 
 	void setValue(const T& value) {
@@ -63,10 +162,10 @@ struct Interpolated{
 
 	[[nodiscard]]
 	T getValue() const {
-		float elapsed = GetElapsedTime();
-		if (elapsed <= 0.0f) return start;
-		if (elapsed >= 1.0f) return end;
-		return start + (end - start) * elapsed;
+		float t = GetProgress();
+		if (t <= 0.0f) return start;
+		if (t >= 1.0f) return end;
+		return start + (end - start) * Ease(InterpolationType, t);
 	}
 
 	[[nodiscard]]
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/*
+	bump allocator for widgets: objects are carved out of large blocks and freed slots are kept on
+	per-size free lists for reuse. the blocks are only returned to the system when the arena dies,
+	so tearing down a whole screen is a handful of frees instead of one per widget.
+	single threaded, like the rest of the GUI.
+*/
+class WidgetArena {
+public:
+	explicit WidgetArena(std::size_t blockSize = 64 * 1024);
+	~WidgetArena();
+
+	WidgetArena(const WidgetArena&) = delete;
+	WidgetArena& operator=(const WidgetArena&) = delete;
+
+	void* Allocate(std::size_t size, std::size_t alignment);
+	void Deallocate(void* pointer, std::size_t size, std::size_t alignment);
+
+	std::size_t BlockCount() const { return blocks.size(); }
+	std::size_t LiveAllocations() const { return live; }
+
+private:
+	static constexpr std::size_t Granularity = alignof(std::max_align_t);
+
+	bool Fits(std::size_t size, std::size_t alignment) const { return alignment <= Granularity && size <= blockSize / 4; }
+	static std::size_t RoundUp(std::size_t size) { return (size + Granularity - 1) / Granularity * Granularity; }
+
+	struct FreeNode { FreeNode* next; };
+
+	std::size_t blockSize;
+	std::vector<std::unique_ptr<std::byte[]>> blocks;
+	std::byte* cursor = nullptr;
+	std::size_t remaining = 0;
+	std::vector<FreeNode*> freeLists;	// indexed by size / Granularity
+	std::size_t live = 0;
+};
+
+// std allocator over a shared arena, for std::allocate_shared. the control block keeps a copy,
+// so the arena lives as long as any widget allocated from it
+template <typename T>
+class ArenaAllocator {
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<WidgetArena> arena) : arena(std::move(arena)) {}
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+	T* allocate(std::size_t n) { return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T* pointer, std::size_t n) { arena->Deallocate(pointer, n * sizeof(T), alignof(T)); }
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+	template <typename U>
+	bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+private:
+	template <typename U> friend class ArenaAllocator;
+	std::shared_ptr<WidgetArena> arena;
+};
@@ -10,12 +10,24 @@
 
 namespace fs = std::filesystem;
 
+// shared handle to a cached font. widgets hold this instead of an sf::Font copy,
+// so everything using the same font (and size) shares one set of glyph pages
+using FontHandle = std::shared_ptr<const sf::Font>;
+
 class AssetManager {
 public:
     static AssetManager& get();
 
     sf::Texture& getTexture(const std::string& filename);
     sf::Font& getFont(const std::string& filename);
+    FontHandle getFontHandle(const std::string& filename);
+
+    // handle to a font. one from getFont is shared as is; any other font is copied, so the caller's
+    // can go away. every such call makes its own copy (and glyph pages): keep one handle to share it
+    static FontHandle wrapFont(const sf::Font& font);
+
+    // file a cached font was loaded from, empty if the font isn't ours
+    std::string getFontFile(const sf::Font& font) const;
 
     AssetManager(const AssetManager&) = delete;
     AssetManager& operator=(const AssetManager&) = delete;
@@ -24,7 +36,7 @@ private:
     AssetManager() = default;
 
     std::unordered_map<std::string, std::unique_ptr<sf::Texture>> textures;
-    std::unordered_map<std::string, std::unique_ptr<sf::Font>> fonts;
+    std::unordered_map<std::string, std::shared_ptr<sf::Font>> fonts;
 
     static fs::path asset_dir;
 };
@@ -0,0 +1,190 @@
+#include "core/AnimationScheduler.hpp"
+#include "utils/EasingBatch.hpp"
+#include <algorithm>
+#include <chrono>
+
+AnimationScheduler::AnimationScheduler() {
+	// seconds since the scheduler was made, small enough to stay precise as a float
+	auto origin = std::chrono::steady_clock::now();
+	clock = [origin] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - origin).count(); };
+	now = clock();
+}
+
+void AnimationScheduler::setClock(Clock newClock) {
+	clock = std::move(newClock);
+	now = clock();
+}
+
+AnimationHandle AnimationScheduler::Start(Tween&& tween, const float* fromValue, const float* toValue, float duration,
+										  InterpolationType easing) {
+	std::uint32_t index;
+	if (!freeSlots.empty()) {
+		index = freeSlots.back();
+		freeSlots.pop_back();
+	} else {
+		index = static_cast<std::uint32_t>(slots.size());
+		slots.emplace_back();
+	}
+	tween.slot = index;
+	slots[index].tween = static_cast<std::uint32_t>(tweens.size());
+	tweens.push_back(std::move(tween));
+	starts.push_back(now);
+	invDurations.push_back(duration > 0.f ? 1.f / duration : 0.f);
+	easings.push_back(easing);
+	for (int c = 0; c < MaxChannels; c++) {
+		from[c].push_back(fromValue[c]);
+		to[c].push_back(toValue[c]);
+	}
+	return {index, slots[index].generation};
+}
+
+AnimationScheduler::Tween* AnimationScheduler::Find(AnimationHandle handle) {
+	return const_cast<Tween*>(static_cast<const AnimationScheduler*>(this)->Find(handle));
+}
+
+const AnimationScheduler::Tween* AnimationScheduler::Find(AnimationHandle handle) const {
+	if (handle.index >= slots.size()) return nullptr;
+	const Slot& slot = slots[handle.index];
+	if (slot.generation != handle.generation || slot.tween == NoTween) return nullptr;
+	const Tween& tween = tweens[slot.tween];
+	return tween.cancelled ? nullptr : &tween;
+}
+
+void AnimationScheduler::setOnFinished(AnimationHandle handle, std::function<void()> onFinished) {
+	if (Tween* tween = Find(handle)) tween->onFinished = std::move(onFinished);
+}
+
+void AnimationScheduler::setOwner(AnimationHandle handle, std::weak_ptr<const void> owner) {
+	if (Tween* tween = Find(handle)) {
+		tween->owner = std::move(owner);
+		tween->owned = true;
+	}
+}
+
+void AnimationScheduler::Cancel(AnimationHandle handle) {
+	Tween* tween = Find(handle);
+	if (!tween) return;
+	if (ticking) {
+		// don't shuffle what the running loop is walking
+		tween->cancelled = true;
+		cancelled++;
+		return;
+	}
+	Retire(slots[handle.index].tween);
+}
+
+void AnimationScheduler::Retire(std::uint32_t index) {
+	Slot& slot = slots[tweens[index].slot];
+	slot.tween = NoTween;
+	slot.generation++;
+	freeSlots.push_back(tweens[index].slot);
+
+	if (index + 1 != tweens.size()) {
+		tweens[index] = std::move(tweens.back());
+		slots[tweens[index].slot].tween = index;
+		starts[index] = starts.back();
+		invDurations[index] = invDurations.back();
+		easings[index] = easings.back();
+		for (int c = 0; c < MaxChannels; c++) {
+			from[c][index] = from[c].back();
+			to[c][index] = to[c].back();
+		}
+	}
+	tweens.pop_back();
+	starts.pop_back();
+	invDurations.pop_back();
+	easings.pop_back();
+	for (int c = 0; c < MaxChannels; c++) {
+		from[c].pop_back();
+		to[c].pop_back();
+	}
+}
+
+int AnimationScheduler::Tick() {
+	now = clock();
+	FrameClock::now = static_cast<float>(now);
+
+	// the tweens running now, ones started by the callbacks below wait for the next tick
+	const std::uint32_t count = static_cast<std::uint32_t>(tweens.size());
+	if (count == 0) return 0;
+
+	progress.resize(count);
+	bool mixed = false;
+	for (std::uint32_t i = 0; i < count; i++) {
+		progress[i] = invDurations[i] > 0.f ? static_cast<float>((now - starts[i]) * invDurations[i]) : 1.f;
+		mixed |= easings[i] != easings[0];
+	}
+
+	// eased in place (clamped to [0, 1] on the way), one batch per easing in use
+	if (!mixed) {
+		EasingBatch::Ease(easings[0], progress.data(), count);
+	} else {
+		std::vector<InterpolationType> kinds;
+		for (std::uint32_t i = 0; i < count; i++) {
+			if (std::find(kinds.begin(), kinds.end(), easings[i]) == kinds.end()) kinds.push_back(easings[i]);
+		}
+		for (InterpolationType kind : kinds) {
+			gathered.clear();
+			gatheredIndex.clear();
+			for (std::uint32_t i = 0; i < count; i++) {
+				if (easings[i] != kind) continue;
+				gathered.push_back(progress[i]);
+				gatheredIndex.push_back(i);
+			}
+			EasingBatch::Ease(kind, gathered.data(), gathered.size());
+			for (std::size_t j = 0; j < gathered.size(); j++) progress[gatheredIndex[j]] = gathered[j];
+		}
+	}
+
+	// eased progress 1 lands exactly on the end value
+	for (int c = 0; c < MaxChannels; c++) {
+		values[c].resize(count);
+		EasingBatch::Lerp(from[c].data(), to[c].data(), progress.data(), values[c].data(), count);
+	}
+
+	ticking = true;
+	int ran = 0;
+	for (std::uint32_t i = 0; i < count; i++) {
+		Tween& tween = tweens[i];
+		if (tween.cancelled) continue;
+		if (tween.owned && tween.owner.expired()) {
+			tween.cancelled = true;
+			cancelled++;
+			continue;
+		}
+
+		// same float as the progress above, so finished always goes with eased progress 1
+		bool finished = invDurations[i] <= 0.f || static_cast<float>((now - starts[i]) * invDurations[i]) >= 1.f;
+		float value[MaxChannels];
+		for (int c = 0; c < MaxChannels; c++) value[c] = values[c][i];
+
+		if (tween.store) {
+			tween.store(tween.target, value);
+		} else {
+			// apply may start tweens and grow the array, so it runs from outside it (tween dangles after)
+			std::function<void(const float*)> apply = std::move(tween.apply);
+			apply(value);
+			tweens[i].apply = std::move(apply);
+		}
+		ran++;
+
+		if (finished && !tweens[i].cancelled) {
+			// marked done before onFinished runs, which may chain a new tween
+			std::function<void()> onFinished = std::move(tweens[i].onFinished);
+			tweens[i].cancelled = true;
+			cancelled++;
+			if (onFinished) onFinished();
+		}
+	}
+	ticking = false;
+
+	// finished, cancelled and orphaned tweens leave together
+	if (cancelled > 0) {
+		for (std::uint32_t i = 0; i < tweens.size(); ) {
+			if (tweens[i].cancelled) Retire(i);
+			else i++;
+		}
+		cancelled = 0;
+	}
+	return ran;
+}
@@ -0,0 +1,60 @@
+#include "core/DamageRegion.hpp"
+#include <algorithm>
+#include <cmath>
+
+sf::FloatRect DamageRegion::Bounding(const sf::FloatRect& a, const sf::FloatRect& b) {
+	float left = std::min(a.left, b.left);
+	float top = std::min(a.top, b.top);
+	float right = std::max(a.left + a.width, b.left + b.width);
+	float bottom = std::max(a.top + a.height, b.top + b.height);
+	return {left, top, right - left, bottom - top};
+}
+
+void DamageRegion::Add(const sf::FloatRect& rect) {
+	if (rect.width <= 0.f || rect.height <= 0.f) return;
+
+	// out to whole pixels: a clip is a viewport, and SFML rounds those, so a fractional rect (an element
+	// in a layout transition) would repaint slightly scaled against the pixels that are kept
+	float left = std::floor(rect.left), top = std::floor(rect.top);
+	sf::FloatRect snapped(left, top, std::ceil(rect.left + rect.width) - left, std::ceil(rect.top + rect.height) - top);
+
+	// merging can make the grown rect overlap ones it missed before, so keep going until nothing touches it
+	sf::FloatRect merged = snapped;
+	for (bool grew = true; grew; ) {
+		grew = false;
+		for (std::size_t i = 0; i < rects.size(); i++) {
+			if (!rects[i].intersects(merged)) continue;
+			merged = Bounding(merged, rects[i]);
+			rects[i] = rects.back();
+			rects.pop_back();
+			grew = true;
+			break;
+		}
+	}
+	rects.push_back(merged);
+
+	if (rects.size() > MaxRects) {
+		sf::FloatRect all = rects[0];
+		for (const auto& r : rects) all = Bounding(all, r);
+		rects.assign(1, all);
+	}
+}
+
+void DamageRegion::ClipTo(const sf::FloatRect& area) {
+	std::size_t kept = 0;
+	for (auto& r : rects) {
+		sf::FloatRect clipped;
+		if (r.intersects(area, clipped)) rects[kept++] = clipped;
+	}
+	rects.resize(kept);
+}
+
+float DamageRegion::Area() const {
+	float area = 0.f;
+	for (const auto& r : rects) area += r.width * r.height;
+	return area;
+}
+
+bool DamageRegion::Intersects(const sf::FloatRect& rect) const {
+	return std::any_of(rects.begin(), rects.end(), [&](const sf::FloatRect& r) { return r.intersects(rect); });
+}
@@ -0,0 +1,25 @@
+#include "core/ElementIndex.hpp"
+#include "core/UIElement.hpp"
+#include <algorithm>
+
+void ElementIndex::Add(UIElement* element) {
+	byName[element->id].push_back(element);
+	count++;
+}
+
+void ElementIndex::Remove(UIElement* element) {
+	auto found = byName.find(element->id);
+	if (found == byName.end()) return;
+
+	auto& list = found->second;
+	auto it = std::find(list.begin(), list.end(), element);
+	if (it == list.end()) return;
+	list.erase(it);	// keeps registration order for duplicate ids
+	count--;
+	if (list.empty()) byName.erase(found);
+}
+
+UIElement* ElementIndex::Find(const std::string& name) const {
+	auto found = byName.find(name);
+	return found == byName.end() ? nullptr : found->second.front();
+}
@@ -1,71 +1,131 @@
 #include "core/ElementManager.hpp"
 #include "core/UIEvent.hpp"
+#include <unordered_set>
+
+GUI::GUI(AllocationMode mode)
+	: allocationMode(mode) {
+	if (mode == AllocationMode::Pooled) arena = std::make_shared<WidgetArena>();
+}
+
+GUI::~GUI() {
+	// elements can outlive the GUI through other shared_ptrs, they must not point at our index
+	for (auto& root : UIRoots) root->AttachTo(nullptr, nullptr);
+	for (auto& slot : slots) if (slot.element) slot.element->AttachTo(nullptr, nullptr);
+}
+
+std::uint32_t GUI::AcquireSlot(std::shared_ptr<UIElement> element) {
+	std::uint32_t index;
+	if (!freeSlots.empty()) {
+		index = freeSlots.back();
+		freeSlots.pop_back();
+	} else {
+		index = static_cast<std::uint32_t>(slots.size());
+		slots.emplace_back();
+	}
+	slots[index].element = std::move(element);
+	return index;
+}
+
+void GUI::DestroySlot(std::uint32_t index, std::uint32_t generation) {
+	if (index >= slots.size() || slots[index].generation != generation || !slots[index].element) return;
+
+	Detach(slots[index].element.get());
+	slots[index].element.reset();
+	slots[index].generation++;
+	freeSlots.push_back(index);
+}
+
+void GUI::DestroyAll() {
+	// only the tops of GUI-owned subtrees need unlinking, everything below goes with them
+	std::unordered_set<const UIElement*> owned;
+	owned.reserve(slots.size());
+	for (auto& slot : slots) if (slot.element) owned.insert(slot.element.get());
+
+	// one sweep per foreign parent instead of a RemoveChild per widget
+	std::unordered_set<UIContainer*> parents;
+	for (auto& slot : slots) {
+		if (!slot.element) continue;
+		auto parentPtr = slot.element->parent.lock();
+		if (!parentPtr) Detach(slot.element.get());
+		else if (!owned.count(parentPtr.get())) parents.insert(dynamic_cast<UIContainer*>(parentPtr.get()));
+	}
+	for (UIContainer* container : parents) {
+		if (!container) continue;
+		std::erase_if(container->children, [&owned](const std::shared_ptr<UIElement>& child) {
+			if (!owned.count(child.get())) return false;
+			child->AttachTo(nullptr, nullptr);
+			child->parent.reset();
+			return true;
+		});
+		container->markLayoutDirty();
+	}
+	UIElement::TreeVersion++;
+
+	for (std::uint32_t i = 0; i < slots.size(); i++) {
+		if (!slots[i].element) continue;
+		slots[i].element.reset();
+		slots[i].generation++;
+		freeSlots.push_back(i);
+	}
+}
+
+void GUI::Detach(UIElement* element) {
+	if (auto parentPtr = element->parent.lock()) {
+		if (auto container = std::dynamic_pointer_cast<UIContainer>(parentPtr)) container->RemoveChild(element);
+		return;
+	}
+
+	auto it = std::find_if(UIRoots.begin(), UIRoots.end(), [element](const auto& root) { return root.get() == element; });
+	if (it == UIRoots.end()) return;
+	(*it)->AttachTo(nullptr, nullptr);
+	renderer.ReleaseLayer(it->get());
+	UIRoots.erase(it);
+	UIElement::TreeVersion++;
+}
 
 std::shared_ptr<UIRoot> GUI::CreateRoot() {
     std::shared_ptr<UIRoot> root;
-    root = std::make_shared<UIRoot>();
+    root = Make<UIRoot>();
+	root->AttachTo(nullptr, &context);
     UIRoots.push_back(root);
+	UIElement::TreeVersion++;
     return root;
 }
 
 std::shared_ptr<UIList> GUI::CreateList() {
     std::shared_ptr<UIList> list;
-    list = std::make_shared<UIList>();
+    list = Make<UIList>();
     return list;
 }
 
 
 std::shared_ptr<UIButton> GUI::CreateButton() {
-	auto button = std::make_shared<UIButton>();
+	auto button = Make<UIButton>();
 	return button;
 }
 
 std::shared_ptr<UILabel> GUI::CreateLabel() {
-	auto label = std::make_shared<UILabel>();
+	auto label = Make<UILabel>();
 	return label;
 }
 
 std::shared_ptr<UITextField> GUI::CreateTextField() {
-	auto TextField = std::make_shared<UITextField>();
+	auto TextField = Make<UITextField>();
 	return TextField;
 }
 
 std::shared_ptr<UISlider> GUI::CreateSlider() {
-	auto Slider = std::make_shared<UISlider>();
+	auto Slider = Make<UISlider>();
 	return Slider;
 }
 
 std::shared_ptr<UIElement> GUI::GetElementByName(const std::string& name) {
-    for (const auto& root : UIRoots) {
-        auto found = FindElementRecursive(root, name);
-        if (found) return found;
-    }
-    return nullptr;
+	UIElement* element = context.names.Find(name);
+	return element ? element->shared_from_this() : nullptr;
 }
 
 void GUI::RemoveElementByName(const std::string& name) {
-    UIRoots.erase(
-        std::remove_if(UIRoots.begin(), UIRoots.end(),
-            [&name](const std::shared_ptr<UIRoot>& element) {
-                return element->id == name;
-            }),
-        UIRoots.end()
-    );
-}
-
-std::shared_ptr<UIElement> GUI::FindElementRecursive(const std::shared_ptr<UIElement>& element, const std::string& name) {
-    if (element->id == name) {
-        return element;
-    }
-    // Only UIContainer and derived types have children
-    auto container = std::dynamic_pointer_cast<UIContainer>(element);
-    if (container) {
-        for (const auto& child : container->children) {
-            auto found = FindElementRecursive(child, name);
-            if (found) return found;
-        }
-    }
-    return nullptr;
+	if (UIElement* element = context.names.Find(name)) Detach(element);
 }
 
 void GUI::draw(sf::RenderTarget& target, sf::RenderStates states){
@@ -73,22 +133,199 @@ void GUI::draw(sf::RenderTarget& target, sf::RenderStates states){
     // Set to default view (screen-space)	
 	target.setView(target.getDefaultView());
 
-	for(auto& root : UIRoots) root->Render(target, states);
+	// transforms are baked into the batched vertices, the rest of the states apply at flush
+	sf::RenderStates flushStates = states;
+	flushStates.transform = sf::Transform::Identity;
+	renderer.SetTarget(&target, flushStates);
+	draw(renderer, states);
+	renderer.SetTarget(nullptr);
 	// Restore the previous view (world-space)
     target.setView(oldView);
 }
 
+void GUI::draw(RenderBackend& backend, sf::RenderStates states){
+	// cleared first, anything marked while drawing asks for the next frame
+	context.paintDirty = false;
+	CollectDamage();
+	backend.Begin();
+	for(auto& root : UIRoots) root->Render(backend, root->WithVisualOffset(states));
+	backend.End();
+
+	frameStats.pixelsRedrawn = 0.f;
+	for (auto& root : UIRoots) {
+		if (!root->enabled || !root->visible) continue;
+		sf::FloatRect bounds = root->getPaintBounds();
+		frameStats.pixelsRedrawn += bounds.width * bounds.height;
+	}
+	FinishFrameStats();
+}
+
+void GUI::drawDamaged(sf::RenderTarget& target, const sf::Color& background, sf::RenderStates states) {
+	sf::View oldView = target.getView();
+	target.setView(target.getDefaultView());
+
+	sf::RenderStates flushStates = states;
+	flushStates.transform = sf::Transform::Identity;
+	renderer.SetTarget(&target, flushStates);
+	sf::Vector2f size(target.getSize());
+	drawDamaged(renderer, background, states.transform.getInverse().transformRect({{0.f, 0.f}, size}), states);
+	renderer.SetTarget(nullptr);
+	target.setView(oldView);
+}
+
+void GUI::drawDamaged(RenderBackend& backend, const sf::Color& background, const sf::FloatRect& area, sf::RenderStates states) {
+	context.paintDirty = false;
+	CollectDamage();
+	damage.ClipTo(area);
+
+	backend.Begin();
+	for (const auto& rect : damage.Rects()) {
+		// everything under the rect is repainted back to front, the roots cull what the clip can't reach
+		backend.PushClip(rect, states);
+		backend.FillRect(rect, background, 0.f, sf::Color::Transparent, states);
+		for (auto& root : UIRoots) root->Render(backend, root->WithVisualOffset(states));
+		backend.PopClip();
+	}
+	backend.End();
+
+	frameStats.pixelsRedrawn = damage.Area();
+	FinishFrameStats();
+}
+
+void GUI::CollectDamage() {
+	damage.Clear();
+	for (const auto& rect : context.damage) damage.Add(rect);
+	context.damage.clear();
+
+	damageScratch.clear();
+	for (UIElement* element : context.paintQueue) {
+		if (element) element->CollectDamage(damageScratch);	// null if it left the tree after being marked
+	}
+	context.paintQueue.clear();
+	for (const auto& rect : damageScratch) damage.Add(rect);
+}
+
+void GUI::FinishFrameStats() {
+	frameStats.damageRects = static_cast<int>(damage.Rects().size());
+	frameStats.elementsDrawn = UIElement::DrawVisits - lastDrawVisits;
+	lastDrawVisits = UIElement::DrawVisits;
+	frameStats.layerHits = UIRoot::LayerHits - lastLayerHits;
+	frameStats.layerMisses = UIRoot::LayerMisses - lastLayerMisses;
+	lastLayerHits = UIRoot::LayerHits;
+	lastLayerMisses = UIRoot::LayerMisses;
+	frameStats.textRebuilds = TextRun::TotalRebuilds - lastTextRebuilds;
+	lastTextRebuilds = TextRun::TotalRebuilds;
+	const TextMeasureCache::Stats& measures = TextMeasureCache::get().GetStats();
+	frameStats.measureHits = static_cast<int>(measures.hits - lastMeasureHits);
+	frameStats.measureMisses = static_cast<int>(measures.misses - lastMeasureMisses);
+	lastMeasureHits = measures.hits;
+	lastMeasureMisses = measures.misses;
+}
+
 void GUI::HandleEvent(const UIEvent& event) {
-    for (auto& root : UIRoots) {
-        root->HandleEvent(event);
-    }
+	if (event.type == UIEventType::MouseMove || event.type == UIEventType::MouseDown || event.type == UIEventType::MouseUp) {
+		DispatchPointer(event);
+		return;
+	}
+	if (event.type == UIEventType::MouseWheel) {
+		DispatchWheel(event);
+		return;
+	}
+
+	if (event.type == UIEventType::KeyDown && event.key == sf::Keyboard::Tab) {
+		RefreshFocusChain();
+		if (event.shift) context.focus.FocusPrevious();
+		else context.focus.FocusNext();
+		return;
+	}
+	context.focus.Dispatch(event);
+}
+
+void GUI::RefreshFocusChain() {
+	if (focusChainVersion == UIElement::TreeVersion) return;
+	focusChainVersion = UIElement::TreeVersion;
+
+	std::vector<UIElement*> roots;
+	roots.reserve(UIRoots.size());
+	for (auto& root : UIRoots) roots.push_back(root.get());
+	context.focus.Rebuild(roots);
+}
+
+UIElement* GUI::HitTest(const sf::Vector2f& point) {
+	// later roots are drawn on top
+	for (auto it = UIRoots.rbegin(); it != UIRoots.rend(); ++it) {
+		if (UIElement* hit = (*it)->HitTest(point - (*it)->e_visualOffset)) return hit;
+	}
+	return nullptr;
+}
+
+void GUI::DispatchPointer(const UIEvent& event) {
+	std::shared_ptr<UIElement> target;
+	if (UIElement* hit = HitTest(event.mousePos)) target = hit->shared_from_this();
+
+	// each element sees the event once, in its own coordinate space
+	std::shared_ptr<UIElement> receivers[3];
+	int count = 0;
+	auto add = [&](const std::shared_ptr<UIElement>& element) {
+		if (!element) return;
+		for (int i = 0; i < count; i++) if (receivers[i] == element) return;
+		receivers[count++] = element;
+	};
+
+	switch (event.type) {
+		case UIEventType::MouseMove:
+			add(hovered.lock());
+			add(target);
+			add(captured.lock());
+			hovered = target;
+			break;
+		case UIEventType::MouseDown:
+			// clicking anything else (or nothing) takes the focus away
+			context.focus.SetFocus(target.get());
+			add(lastPressed.lock());
+			add(target);
+			captured = target;
+			lastPressed = target;
+			break;
+		default:
+			add(captured.lock());
+			add(target);
+			captured.reset();
+			break;
+	}
+
+	for (int i = 0; i < count; i++) {
+		UIEvent local = event;
+		local.mousePos -= receivers[i]->getGlobalPosition() - receivers[i]->e_position;
+		receivers[i]->HandleSelfEvent(local);
+	}
+}
+
+void GUI::DispatchWheel(const UIEvent& event) {
+	UIElement* element = HitTest(event.mousePos);
+	while (element && !element->WantsWheel()) element = element->parent.lock().get();
+	if (!element) return;
+
+	UIEvent local = event;
+	local.mousePos -= element->getGlobalPosition() - element->e_position;
+	element->HandleSelfEvent(local);
 }
 
 void GUI::Update(const float dt) {
+	// animations first, what they change is laid out and drawn this frame
+	frameStats.animated = context.animations.Tick();
+	// only widgets that registered for it tick, before layout so what they change is measured this frame
+	frameStats.ticked = context.ticks.Tick(dt);
+
 	for (auto& root : UIRoots) {
-		while(root->layoutDirty) root->CalculateLayout();
-		root->Update(dt);
+		// only dirty subtrees are walked, a clean tree costs nothing
+		if (root->enabled && root->NeedsLayout()) root->CalculateLayout();
 	}
+
+	frameStats.layoutVisited = UIElement::LayoutVisits - lastLayoutVisits;
+	frameStats.layoutRecomputed = UIElement::LayoutRecomputes - lastLayoutRecomputes;
+	lastLayoutVisits = UIElement::LayoutVisits;
+	lastLayoutRecomputes = UIElement::LayoutRecomputes;
 }
 
 void GUI::ProcessEvent(const sf::Event& event) {
@@ -101,6 +338,12 @@ void GUI::ProcessEvent(const sf::Event& event) {
     } else if (event.type == sf::Event::MouseButtonReleased) {
         UIEvent uievt{UIEventType::MouseUp, sf::Vector2f(event.mouseButton.x, event.mouseButton.y), event.mouseButton.button};
         HandleEvent(uievt);
+    } else if (event.type == sf::Event::MouseWheelScrolled) {
+		if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
+			UIEvent uievt{UIEventType::MouseWheel, sf::Vector2f(event.mouseWheelScroll.x, event.mouseWheelScroll.y)};
+			uievt.wheelDelta = event.mouseWheelScroll.delta;
+			HandleEvent(uievt);
+		}
     } else if (event.type == sf::Event::KeyPressed) {
         UIEvent uievt{UIEventType::KeyDown, sf::Vector2f(0, 0), 0, event.key.code};
 		uievt.ctrl  = event.key.control;
@@ -0,0 +1,120 @@
+#include "core/ElementStore.hpp"
+#include "core/UIElement.hpp"
+
+std::uint8_t ElementStore::FlagsOf(const UIElement& element) {
+	std::uint8_t result = 0;
+	if (element.enabled) result |= Enabled;
+	if (element.visible) result |= Visible;
+	if (dynamic_cast<const UIContainer*>(&element)) result |= Container;
+	return result;
+}
+
+void ElementStore::Ensure() {
+	if (dirty) Rebuild();
+}
+
+void ElementStore::Rebuild() {
+	dirty = false;
+	elements.clear();
+	positions.clear();
+	sizes.clear();
+	drawBounds.clear();
+	parents.clear();
+	subtreeEnds.clear();
+	flags.clear();
+	offsets.clear();
+	moving = 0;
+	grid.Clear();
+
+	auto container = dynamic_cast<UIContainer*>(owner);
+	if (!container) return;
+	for (auto& child : container->children) Collect(child.get(), -1);
+}
+
+void ElementStore::Collect(UIElement* element, std::int32_t parentSlot) {
+	const auto slot = static_cast<std::uint32_t>(elements.size());
+	element->storeSlot = static_cast<std::int32_t>(slot);
+	elements.push_back(element);
+	positions.push_back(element->e_position);
+	sizes.push_back(element->e_size);
+	drawBounds.push_back(element->getDrawBounds());
+	parents.push_back(parentSlot);
+	subtreeEnds.push_back(slot + 1);
+	flags.push_back(FlagsOf(*element));
+	offsets.push_back(element->e_visualOffset);
+	if (element->e_visualOffset != sf::Vector2f(0, 0)) moving++;
+	grid.Update(slot, element->getHitBounds());
+
+	// nested roots keep their children in their own store
+	auto container = dynamic_cast<UIContainer*>(element);
+	if (container && container->ChildStore() != this) flags[slot] |= Boundary;
+	if (container && container->ChildStore() == this) {
+		for (auto& child : container->children) Collect(child.get(), static_cast<std::int32_t>(slot));
+	}
+	subtreeEnds[slot] = static_cast<std::uint32_t>(elements.size());
+}
+
+void ElementStore::SyncBounds(const UIElement& element) {
+	if (dirty || element.storeSlot < 0) return;
+	const auto slot = static_cast<std::uint32_t>(element.storeSlot);
+	positions[slot] = element.e_position;
+	sizes[slot] = element.e_size;
+	drawBounds[slot] = element.getDrawBounds();
+	grid.Update(slot, element.getHitBounds());
+}
+
+void ElementStore::SyncFlags(const UIElement& element) {
+	if (dirty || element.storeSlot < 0) return;
+	flags[element.storeSlot] = FlagsOf(element) | (flags[element.storeSlot] & Boundary);
+}
+
+void ElementStore::SyncOffset(const UIElement& element) {
+	if (dirty || element.storeSlot < 0) return;
+	sf::Vector2f& offset = offsets[element.storeSlot];
+	bool was = offset != sf::Vector2f(0, 0);
+	bool now = element.e_visualOffset != sf::Vector2f(0, 0);
+	offset = element.e_visualOffset;
+	if (was != now) {
+		if (now) moving++;
+		else moving--;
+	}
+}
+
+sf::Vector2f ElementStore::VisualOffset(std::int32_t slot) const {
+	sf::Vector2f offset(0, 0);
+	for (std::int32_t s = slot; s >= 0; s = parents[s]) offset += offsets[s];
+	return offset;
+}
+
+bool ElementStore::Reachable(std::int32_t slot) const {
+	// hidden elements (or ones under a hidden parent) don't take clicks from what's drawn below them
+	for (std::int32_t s = slot; s >= 0; s = parents[s]) {
+		if ((flags[s] & (Enabled | Visible)) != (Enabled | Visible)) return false;
+	}
+	return true;
+}
+
+std::int32_t ElementStore::TopmostAt(const sf::Vector2f& point) {
+	Ensure();
+
+	// the grid holds layout bounds, moved elements are checked one by one (only while something animates)
+	if (moving > 0) {
+		for (auto slot = static_cast<std::int32_t>(elements.size()) - 1; slot >= 0; slot--) {
+			sf::FloatRect bounds = elements[slot]->getHitBounds();
+			sf::Vector2f offset = VisualOffset(slot);
+			bounds.left += offset.x;
+			bounds.top += offset.y;
+			if (bounds.contains(point) && Reachable(slot)) return slot;
+		}
+		return -1;
+	}
+
+	// pre-order is paint order, so the highest slot is on top
+	std::int32_t best = -1;
+	for (std::uint32_t candidate : grid.Query(point)) {
+		auto slot = static_cast<std::int32_t>(candidate);
+		if (slot <= best) continue;
+		if (Reachable(slot)) best = slot;
+	}
+	return best;
+}
@@ -0,0 +1,66 @@
+#include "core/FocusManager.hpp"
+#include "core/UIElement.hpp"
+
+void FocusManager::SetFocus(UIElement* element) {
+	auto previous = focused.lock();
+	if (previous && previous.get() != element) previous->OnFocusChanged(false);
+
+	if (element && element->IsFocusable() && element->enabled) {
+		focused = element->weak_from_this();
+		element->OnFocusChanged(true);
+	} else {
+		focused.reset();
+	}
+}
+
+bool FocusManager::FocusNext() { return Step(1); }
+bool FocusManager::FocusPrevious() { return Step(-1); }
+
+bool FocusManager::Step(int direction) {
+	if (chain.empty()) return false;
+	const long long count = static_cast<long long>(chain.size());
+
+	// start from the focused element, or just outside the chain so the first step lands on an end
+	long long index = direction > 0 ? -1 : count;
+	if (auto current = focused.lock()) {
+		auto found = chainIndex.find(current.get());
+		if (found != chainIndex.end()) index = static_cast<long long>(found->second);
+	}
+
+	for (long long tries = 0; tries < count; tries++) {
+		index = ((index + direction) % count + count) % count;
+		auto candidate = chain[index].lock();
+		if (candidate && candidate->enabled) {
+			SetFocus(candidate.get());
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FocusManager::Dispatch(const UIEvent& event) {
+	auto target = focused.lock();
+	if (!target) return false;
+
+	target->HandleSelfEvent(event);
+	for (auto parentPtr = target->parent.lock(); parentPtr; parentPtr = parentPtr->parent.lock()) {
+		parentPtr->HandleSelfEvent(event);
+	}
+	return true;
+}
+
+void FocusManager::Rebuild(const std::vector<UIElement*>& roots) {
+	chain.clear();
+	chainIndex.clear();
+	for (UIElement* root : roots) Collect(root);
+}
+
+void FocusManager::Collect(UIElement* element) {
+	if (element->IsFocusable()) {
+		chainIndex[element] = chain.size();
+		chain.push_back(element->weak_from_this());
+	}
+	if (auto container = dynamic_cast<UIContainer*>(element)) {
+		for (auto& child : container->children) Collect(child.get());
+	}
+}
@@ -0,0 +1,84 @@
+#include "core/HitGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	void EraseOne(std::vector<std::uint32_t>& list, std::uint32_t slot) {
+		auto it = std::find(list.begin(), list.end(), slot);
+		if (it == list.end()) return;
+		*it = list.back();
+		list.pop_back();
+	}
+}
+
+sf::IntRect HitGrid::CellsFor(const sf::FloatRect& bounds) const {
+	int left = static_cast<int>(std::floor(bounds.left / cellSize));
+	int top = static_cast<int>(std::floor(bounds.top / cellSize));
+	int right = static_cast<int>(std::floor((bounds.left + bounds.width) / cellSize));
+	int bottom = static_cast<int>(std::floor((bounds.top + bounds.height) / cellSize));
+	return {left, top, right, bottom};
+}
+
+void HitGrid::Update(std::uint32_t slot, const sf::FloatRect& bounds) {
+	sf::IntRect range = CellsFor(bounds);
+	bool big = (static_cast<long long>(range.width - range.left + 1) * (range.height - range.top + 1)) > MaxCellsPerElement;
+
+	if (slot >= entries.size()) entries.resize(slot + 1);
+	Entry& entry = entries[slot];
+	if (entry.present) {
+		// still in the same cells, only the bounds moved
+		if (entry.oversized == big && (big || entry.cells == range)) {
+			entry.bounds = bounds;
+			return;
+		}
+		Unlink(slot, entry);
+	}
+
+	entry.bounds = bounds;
+	entry.cells = range;
+	entry.oversized = big;
+	entry.present = true;
+
+	if (big) {
+		oversized.push_back(slot);
+		return;
+	}
+	for (int y = range.top; y <= range.height; y++)
+		for (int x = range.left; x <= range.width; x++)
+			cells[Key(x, y)].push_back(slot);
+}
+
+void HitGrid::Clear() {
+	entries.clear();
+	cells.clear();
+	oversized.clear();
+}
+
+void HitGrid::Unlink(std::uint32_t slot, const Entry& entry) {
+	if (entry.oversized) {
+		EraseOne(oversized, slot);
+		return;
+	}
+	for (int y = entry.cells.top; y <= entry.cells.height; y++) {
+		for (int x = entry.cells.left; x <= entry.cells.width; x++) {
+			auto cell = cells.find(Key(x, y));
+			if (cell == cells.end()) continue;
+			EraseOne(cell->second, slot);
+			if (cell->second.empty()) cells.erase(cell);
+		}
+	}
+}
+
+const std::vector<std::uint32_t>& HitGrid::Query(const sf::Vector2f& point) {
+	results.clear();
+	auto consider = [&](std::uint32_t slot) {
+		if (entries[slot].bounds.contains(point)) results.push_back(slot);
+	};
+
+	auto cell = cells.find(Key(static_cast<int>(std::floor(point.x / cellSize)), static_cast<int>(std::floor(point.y / cellSize))));
+	if (cell != cells.end()) {
+		for (std::uint32_t slot : cell->second) consider(slot);
+	}
+	for (std::uint32_t slot : oversized) consider(slot);
+	return results;
+}
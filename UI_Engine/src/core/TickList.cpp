@@ -0,0 +1,70 @@
+#include "core/TickList.hpp"
+#include "core/UIElement.hpp"
+#include <algorithm>
+#include <limits>
+
+void TickList::Set(UIElement* element, bool active) {
+	auto found = index.find(element);
+	if (active) {
+		if (found != index.end()) return;
+		index[element] = elements.size();
+		elements.push_back(element);
+		return;
+	}
+
+	if (found == index.end()) return;
+	std::size_t slot = found->second;
+	index.erase(found);
+	if (ticking) {
+		// don't shuffle what the running loop is walking
+		elements[slot] = nullptr;
+		hasHoles = true;
+		return;
+	}
+	elements[slot] = elements.back();
+	elements.pop_back();
+	if (slot < elements.size()) index[elements[slot]] = slot;
+}
+
+int TickList::Tick(const float dt) {
+	ticking = true;
+	int ran = 0;
+	// elements added by a callback are appended and get their first tick this frame
+	for (std::size_t i = 0; i < elements.size(); i++) {
+		UIElement* element = elements[i];
+		if (!element || !element->enabled) continue;
+
+		bool reachable = true;
+		for (auto parentPtr = element->parent.lock(); parentPtr; parentPtr = parentPtr->parent.lock()) {
+			if (!parentPtr->enabled) {
+				reachable = false;
+				break;
+			}
+		}
+		if (!reachable) continue;
+
+		element->UpdateSelf(dt);
+		ran++;
+	}
+	ticking = false;
+
+	if (hasHoles) {
+		hasHoles = false;
+		std::size_t kept = 0;
+		for (UIElement* element : elements) {
+			if (!element) continue;
+			index[element] = kept;
+			elements[kept++] = element;
+		}
+		elements.resize(kept);
+	}
+	return ran;
+}
+
+float TickList::NextDue() const {
+	float due = std::numeric_limits<float>::infinity();
+	for (const UIElement* element : elements) {
+		if (element && element->enabled) due = std::min(due, element->NextTickIn());
+	}
+	return due;
+}
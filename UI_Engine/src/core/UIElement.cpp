@@ -1,30 +1,311 @@
 #include "core/UIElement.hpp"
+#include <algorithm>
 
 UIElement::UIElement(const std::string& id)
     : id(id) {
     ElementCount++;
 }
 
+UIElement::~UIElement() {
+	if (store) store->MarkDirty();
+	if (context) LeaveContext();
+}
+
+void UIElement::LeaveContext() {
+	// the tween belongs to this context's scheduler and points at us
+	StopTransition();
+	context->names.Remove(this);
+	context->ticks.Set(this, false);
+	if (paintQueueSlot >= 0) {
+		context->paintQueue[paintQueueSlot] = nullptr;
+		paintQueueSlot = -1;
+	}
+	if (paintedBounds.width > 0.f || paintedBounds.height > 0.f) {
+		context->damage.push_back(paintedBounds);
+		context->paintDirty = true;
+	}
+	paintedBounds = sf::FloatRect();
+}
+
+void UIElement::AttachTo(ElementStore* newStore, GUIContext* newContext) {
+	if (store != newStore) {
+		if (store) store->MarkDirty();
+		store = newStore;
+		storeSlot = -1;
+		if (store) store->MarkDirty();
+	}
+	if (context != newContext) {
+		if (context) LeaveContext();
+		context = newContext;
+		if (context) {
+			context->names.Add(this);
+			context->ticks.Set(this, WantsTick());
+			markPaintDirty();
+		}
+	}
+}
+
+void UIElement::markPaintDirty(bool contentChanged) {
+	if (!context) return;
+	context->paintDirty = true;
+	if (paintQueueSlot < 0) {
+		paintQueueSlot = static_cast<std::int32_t>(context->paintQueue.size());
+		context->paintQueue.push_back(this);
+	}
+
+	// every cached layer this element is drawn into is stale now
+	if (contentChanged) InvalidateLayer();
+	for (auto parentPtr = parent.lock(); parentPtr; parentPtr = parentPtr->parent.lock()) {
+		parentPtr->InvalidateLayer();
+	}
+}
+
+sf::FloatRect UIElement::getPaintBounds() const {
+	sf::FloatRect bounds = getDrawBounds();
+	sf::Vector2f global = getGlobalPosition();
+	bounds.left += global.x - e_position.x;
+	bounds.top += global.y - e_position.y;
+	return {bounds.left - PaintMargin, bounds.top - PaintMargin, bounds.width + PaintMargin * 2.f, bounds.height + PaintMargin * 2.f};
+}
+
+void UIElement::CollectDamage(std::vector<sf::FloatRect>& out) {
+	paintQueueSlot = -1;
+	if (paintedBounds.width > 0.f || paintedBounds.height > 0.f) out.push_back(paintedBounds);
+	paintedBounds = getPaintBounds();
+	out.push_back(paintedBounds);
+}
+
+void UIElement::RefreshTick() {
+	if (context) context->ticks.Set(this, WantsTick());
+}
+
+void UIElement::CalculateLayout() {
+	sf::Vector2f origin(0, 0), area(0, 0);
+	if (auto parentPtr = parent.lock()) {
+		origin = parentPtr->e_position - parentPtr->ChildTranslation() + parentPtr->e_padding;
+		area = parentPtr->e_size - parentPtr->e_padding * 2.f;
+	}
+	Measure(area);
+	PlaceAt(ResolvePosition(origin, area));
+}
+
+sf::Vector2f UIElement::Measure(const sf::Vector2f& available) {
+	bool contentDirty = childLayoutDirty && sizeType == SizeType::FitContent;
+	if (hasLayout && !layoutDirty && !contentDirty && available == measuredAvailable) return e_size;
+	measuredAvailable = available;
+
+	bool hasParent = !parent.expired();
+	switch (sizeType) {
+		case SizeType::Absolute:
+			e_size = e_requestedSize;
+			break;
+		case SizeType::FitContent:
+			e_size = MeasureContent(available);
+			break;
+		case SizeType::FillParent:
+			e_size = hasParent ? available - e_offset : e_requestedSize;
+			break;
+		case SizeType::Percent:
+			e_size = hasParent ? sf::Vector2f(available.x * (e_requestedSize.x / 100.f), available.y * (e_requestedSize.y / 100.f)) : e_requestedSize;
+			break;
+	}
+	return e_size;
+}
+
+void UIElement::PlaceAt(const sf::Vector2f& position) {
+	LayoutVisits++;
+	bool moved = !hasLayout || layoutDirty || position != e_position || e_size != arrangedSize;
+	if (!moved && !childLayoutDirty) return;
+
+	if (moved) {
+		LayoutRecomputes++;
+		markPaintDirty(!hasLayout || layoutDirty || e_size != arrangedSize);
+		Relocate(position);
+		arrangedSize = e_size;
+		if (store) store->SyncBounds(*this);
+	}
+	hasLayout = true;
+	layoutDirty = false;
+	childLayoutDirty = false;
+
+	ArrangeChildren();
+}
+
+void UIElement::Relocate(const sf::Vector2f& position) {
+	// following a moving parent is covered by the parent's own offset, only a move within it animates
+	sf::Vector2f relative = position - ParentOrigin();
+	if (hasLayout && relative != placedRelative) {
+		float duration = transitionDuration;
+		InterpolationType easing = transitionEasing;
+		if (duration <= 0.f) {
+			auto parentPtr = parent.lock();
+			if (parentPtr && parentPtr->AnimatesChildren()) {
+				duration = parentPtr->transitionDuration;
+				easing = parentPtr->transitionEasing;
+			}
+		}
+
+		if (snapNextMove || duration <= 0.f || !context) {
+			StopTransition();
+		} else {
+			// drawn where it was, then eased into place from wherever a running transition had it
+			context->animations.Cancel(transitionTween);
+			SetVisualOffset(e_visualOffset + placedRelative - relative);
+			transitionTween = context->animations.Animate<sf::Vector2f>(e_visualOffset, {0, 0}, duration,
+				[this](const sf::Vector2f& offset) { SetVisualOffset(offset); }, easing);
+		}
+	}
+	snapNextMove = false;
+	placedRelative = relative;
+	e_position = position;
+}
+
+sf::Vector2f UIElement::ParentOrigin() const {
+	auto parentPtr = parent.lock();
+	return parentPtr ? parentPtr->e_position - parentPtr->ChildTranslation() : sf::Vector2f(0, 0);
+}
+
+void UIElement::MoveTo(const sf::Vector2f& position) {
+	if (position == e_position) return;
+	markPaintDirty(false);
+	Relocate(position);
+	if (store) store->SyncBounds(*this);
+}
+
+void UIElement::SetLayoutTransition(float seconds, InterpolationType easing) {
+	transitionDuration = seconds;
+	transitionEasing = easing;
+}
+
+void UIElement::SetVisualOffset(const sf::Vector2f& offset) {
+	if (offset == e_visualOffset) return;
+	markPaintDirty(false);
+	e_visualOffset = offset;
+	if (store) store->SyncOffset(*this);
+}
+
+void UIElement::StopTransition() {
+	if (context) context->animations.Cancel(transitionTween);
+	transitionTween = {};
+	if (e_visualOffset != sf::Vector2f(0, 0)) {
+		e_visualOffset = {0, 0};
+		if (store) store->SyncOffset(*this);
+	}
+}
+
+void UIElement::SetEnabled(bool en) {
+	enabled = en;
+	if (store) store->SyncFlags(*this);
+	markPaintDirty();
+}
+
+void UIElement::SetVisible(bool vis) {
+	visible = vis;
+	if (store) store->SyncFlags(*this);
+	markPaintDirty();
+}
+
+sf::Vector2f UIElement::getGlobalPosition() const {
+	sf::Vector2f position = e_position + e_visualOffset;
+	for (auto parentPtr = parent.lock(); parentPtr; parentPtr = parentPtr->parent.lock()) {
+		position += parentPtr->ChildTranslation() + parentPtr->e_visualOffset;
+	}
+	return position;
+}
+
+sf::Vector2f UIElement::ResolvePosition(const sf::Vector2f& origin, const sf::Vector2f& area) const {
+	switch (layoutType) {
+		case LayoutType::Relative:
+			return origin + e_offset;
+		case LayoutType::Percent:
+			return {origin.x + area.x * (e_offset.x / 100.f), origin.y + area.y * (e_offset.y / 100.f)};
+		case LayoutType::Static:
+		case LayoutType::Anchor:
+		default:
+			return e_offset;
+	}
+}
+
 UIContainer::UIContainer(const std::string& id)
     : UIElement(id) {}
 
-void UIContainer::Render(sf::RenderTarget& target, sf::RenderStates states) {
+void UIContainer::Render(RenderBackend& renderer, sf::RenderStates states) {
 	if(!enabled) return;
 
-    DrawSelf(target, states);
+	DrawVisits++;
+    DrawSelf(renderer, states);
+
+	sf::Vector2f translation = ChildTranslation();
+	if (translation != sf::Vector2f(0, 0)) states.transform.translate(translation);
     for (const auto& child : children) {
-        child->Render(target, states);
+        child->Render(renderer, child->WithVisualOffset(states));
     }
 }
 
 UIElement* UIContainer::AddChild(std::shared_ptr<UIElement> child) {
-    children.push_back(child);
+	return InsertChild(children.size(), std::move(child));
+}
+
+UIElement* UIContainer::InsertChild(std::size_t index, std::shared_ptr<UIElement> child) {
+	children.insert(children.begin() + std::min(index, children.size()), child);
     child->parent = shared_from_this();
+	child->AttachTo(ChildStore(), context);
+	if (ChildStore()) ChildStore()->MarkDirty();
+	markLayoutDirty();
+	TreeVersion++;
     return child.get();
 }
 
+std::shared_ptr<UIElement> UIContainer::RemoveChild(UIElement* child) {
+	auto it = std::find_if(children.begin(), children.end(), [child](const auto& c) { return c.get() == child; });
+	if (it == children.end()) return nullptr;
+
+	std::shared_ptr<UIElement> removed = std::move(*it);
+	children.erase(it);
+	removed->AttachTo(nullptr, nullptr);
+	removed->parent.reset();
+	if (ChildStore()) ChildStore()->MarkDirty();
+	markLayoutDirty();
+	TreeVersion++;
+	return removed;
+}
+
+sf::Vector2f UIContainer::MeasureContent(const sf::Vector2f& available) {
+	// our own size is what's being measured, so children see the content area of the last pass
+	sf::Vector2f area = e_size - e_padding * 2.f;
+	sf::Vector2f maxSize(0, 0);
+	for (const auto& child : children) {
+		child->Measure(area);
+		sf::Vector2f childBR = e_padding + child->ResolvePosition({0, 0}, area) + child->e_size;
+		maxSize.x = std::max(maxSize.x, childBR.x);
+		maxSize.y = std::max(maxSize.y, childBR.y);
+	}
+	return maxSize + e_padding * 2.f;
+}
+
+void UIContainer::ArrangeChildren() {
+	sf::Vector2f origin = e_position - ChildTranslation() + e_padding;
+	sf::Vector2f area = e_size - e_padding * 2.f;
+	for (auto& child : children) {
+		child->Measure(area);
+		child->PlaceAt(child->ResolvePosition(origin, area));
+	}
+}
+
+void UIContainer::AttachTo(ElementStore* newStore, GUIContext* newContext) {
+	UIElement::AttachTo(newStore, newContext);
+	for (auto& child : children) {
+		child->AttachTo(ChildStore(), context);
+	}
+}
+
 void UIContainer::HandleEvent(const UIEvent& event) {
+	if (!enabled) return;
+	HandleSelfEvent(event);
+
+	UIEvent local = event;
+	local.mousePos -= ChildTranslation();
     for (auto& child : children) {
-        child->HandleEvent(event);
+        child->HandleEvent(local);
     }
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include "renderer/GlyphAtlas.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+	constexpr std::uint32_t NoShelf = std::numeric_limits<std::uint32_t>::max();	// glyphs without a bitmap (spaces)
+}
+
+GlyphAtlas& GlyphAtlas::get() {
+	static GlyphAtlas instance;
+	return instance;
+}
+
+GlyphAtlas::GlyphAtlas() {
+	setBudget(budget);
+}
+
+void GlyphAtlas::setBudget(std::size_t bytes) {
+	budget = std::max<std::size_t>(bytes, 64 * 64 * 4);
+
+	// widest power of two that still leaves a square page inside the budget, capped at 1024
+	unsigned int newWidth = 64;
+	while (newWidth < 1024 && static_cast<std::size_t>(newWidth) * 2 * newWidth * 2 * 4 <= budget) newWidth *= 2;
+	if (newWidth != width || static_cast<std::size_t>(width) * height * 4 > budget) Reset(newWidth);
+}
+
+void GlyphAtlas::Clear() {
+	Reset(width);
+}
+
+void GlyphAtlas::Reset(unsigned int newWidth) {
+	if (!glyphs.empty()) NotifyEviction();
+	width = newWidth;
+	height = std::min<unsigned int>(InitialHeight, static_cast<unsigned int>(budget / (static_cast<std::size_t>(width) * 4)));
+
+	// white everywhere, coverage goes in alpha
+	pixels.assign(static_cast<std::size_t>(width) * height * 4, 255);
+	for (std::size_t i = 3; i < pixels.size(); i += 4) pixels[i] = 0;
+	for (unsigned int y = 0; y < WhiteSize; y++) {
+		for (unsigned int x = 0; x < WhiteSize; x++) pixels[(static_cast<std::size_t>(y) * width + x) * 4 + 3] = 255;
+	}
+
+	glyphs.clear();
+	shelves.clear();
+	nextShelfY = WhiteSize;
+	rasterizer.ClearGlyphs();
+	textureStale = true;
+	dirty = sf::IntRect();
+	generation++;
+}
+
+const sf::Glyph* GlyphAtlas::GetGlyph(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize) {
+	Key key{&font, codePoint, characterSize};
+	auto found = glyphs.find(key);
+	if (found != glyphs.end()) {
+		if (found->second.shelf != NoShelf) shelves[found->second.shelf].lastUsed = ++tick;
+		return &found->second.glyph;
+	}
+
+	const RasterGlyph* raster = rasterizer.GetGlyph(font, codePoint, characterSize);
+	if (!raster) return nullptr;
+
+	// copied out, packing may evict and with it the rasterizer's cache
+	sf::Glyph glyph;
+	glyph.advance = raster->advance;
+	glyph.lsbDelta = raster->lsbDelta;
+	glyph.rsbDelta = raster->rsbDelta;
+	glyph.bounds = sf::FloatRect(static_cast<float>(raster->left), static_cast<float>(raster->top),
+								 static_cast<float>(raster->width), static_cast<float>(raster->height));
+	const unsigned int w = raster->width, h = raster->height;
+	std::vector<std::uint8_t> coverage = raster->coverage;
+
+	std::uint32_t shelfIndex = NoShelf;
+	sf::Vector2u position;
+	if (w > 0 && h > 0 && Allocate(w + Padding * 2, h + Padding * 2, position, shelfIndex)) {
+		position.x += Padding;
+		position.y += Padding;
+		for (unsigned int y = 0; y < h; y++) {
+			std::uint8_t* row = pixels.data() + (static_cast<std::size_t>(position.y + y) * width + position.x) * 4;
+			for (unsigned int x = 0; x < w; x++) row[x * 4 + 3] = coverage[static_cast<std::size_t>(y) * w + x];
+		}
+		glyph.textureRect = sf::IntRect(static_cast<int>(position.x), static_cast<int>(position.y), static_cast<int>(w), static_cast<int>(h));
+		MarkDirty(glyph.textureRect);
+	}
+
+	Entry& entry = glyphs[key];
+	entry.glyph = glyph;
+	entry.shelf = shelfIndex;
+	if (shelfIndex != NoShelf) {
+		shelves[shelfIndex].keys.push_back(key);
+		shelves[shelfIndex].lastUsed = ++tick;
+	}
+	return &entry.glyph;
+}
+
+bool GlyphAtlas::Allocate(unsigned int w, unsigned int h, sf::Vector2u& position, std::uint32_t& shelfIndex) {
+	const unsigned int maxHeight = static_cast<unsigned int>(budget / (static_cast<std::size_t>(width) * 4));
+	if (w > width || h > maxHeight - WhiteSize) return false;
+
+	auto place = [&](std::uint32_t index) {
+		Shelf& shelf = shelves[index];
+		position = {shelf.cursor, shelf.y};
+		shelf.cursor += w;
+		shelfIndex = index;
+		return true;
+	};
+
+	// tightest shelf that has room. one so tall that the glyph wastes most of it is only
+	// taken once no new shelf fits, before anything gets evicted
+	std::uint32_t best = NoShelf;
+	for (std::uint32_t i = 0; i < shelves.size(); i++) {
+		const Shelf& shelf = shelves[i];
+		if (shelf.height < h || width - shelf.cursor < w) continue;
+		if (best == NoShelf || shelf.height < shelves[best].height) best = i;
+	}
+	if (best != NoShelf && shelves[best].height * 3 <= h * 4 + 8) return place(best);
+
+	// open a new shelf at the bottom, growing the page while the budget allows
+	while (nextShelfY + h > height) {
+		if (!Grow()) break;
+	}
+	if (nextShelfY + h <= height) {
+		Shelf shelf;
+		shelf.y = nextShelfY;
+		shelf.height = h;
+		nextShelfY += h;
+		shelves.push_back(shelf);
+		return place(static_cast<std::uint32_t>(shelves.size() - 1));
+	}
+	if (best != NoShelf) return place(best);
+
+	// full: empty the least recently used shelf the glyph fits in
+	std::uint32_t victim = NoShelf;
+	for (std::uint32_t i = 0; i < shelves.size(); i++) {
+		if (shelves[i].height < h) continue;
+		if (victim == NoShelf || shelves[i].lastUsed < shelves[victim].lastUsed) victim = i;
+	}
+	if (victim != NoShelf) {
+		Evict(shelves[victim]);
+		return place(victim);
+	}
+
+	// no shelf is tall enough, free shelves from the bottom until a new one fits
+	while (!shelves.empty() && nextShelfY + h > height) {
+		Evict(shelves.back());
+		nextShelfY = shelves.back().y;
+		shelves.pop_back();
+	}
+	return Allocate(w, h, position, shelfIndex);
+}
+
+bool GlyphAtlas::Grow() {
+	const unsigned int maxHeight = static_cast<unsigned int>(budget / (static_cast<std::size_t>(width) * 4));
+	if (height >= maxHeight) return false;
+
+	// rows are appended, so every glyph keeps its texture rect
+	unsigned int newHeight = std::min(height * 2, maxHeight);
+	std::size_t oldSize = pixels.size();
+	pixels.resize(static_cast<std::size_t>(width) * newHeight * 4, 255);
+	for (std::size_t i = oldSize + 3; i < pixels.size(); i += 4) pixels[i] = 0;
+	height = newHeight;
+	textureStale = true;
+	return true;
+}
+
+void GlyphAtlas::Evict(Shelf& shelf) {
+	NotifyEviction();
+	for (const Key& key : shelf.keys) glyphs.erase(key);
+	shelf.keys.clear();
+	shelf.cursor = 0;
+
+	for (unsigned int y = shelf.y; y < shelf.y + shelf.height; y++) {
+		std::uint8_t* row = pixels.data() + static_cast<std::size_t>(y) * width * 4;
+		for (unsigned int x = 0; x < width; x++) row[x * 4 + 3] = 0;
+	}
+	MarkDirty(sf::IntRect(0, static_cast<int>(shelf.y), static_cast<int>(width), static_cast<int>(shelf.height)));
+
+	// the rasterizer's copies are only a cache, don't let them outgrow the atlas
+	rasterizer.ClearGlyphs();
+	evictions++;
+	generation++;
+}
+
+void GlyphAtlas::AddEvictionListener(const void* owner, std::function<void()> listener) {
+	evictionListeners.emplace_back(owner, std::move(listener));
+}
+
+void GlyphAtlas::RemoveEvictionListener(const void* owner) {
+	std::erase_if(evictionListeners, [owner](const auto& entry) { return entry.first == owner; });
+}
+
+void GlyphAtlas::NotifyEviction() {
+	for (auto& entry : evictionListeners) entry.second();
+}
+
+void GlyphAtlas::MarkDirty(const sf::IntRect& rect) {
+	if (dirty.width == 0 || dirty.height == 0) {
+		dirty = rect;
+		return;
+	}
+	int left = std::min(dirty.left, rect.left);
+	int top = std::min(dirty.top, rect.top);
+	int right = std::max(dirty.left + dirty.width, rect.left + rect.width);
+	int bottom = std::max(dirty.top + dirty.height, rect.top + rect.height);
+	dirty = sf::IntRect(left, top, right - left, bottom - top);
+}
+
+const sf::Texture& GlyphAtlas::GetTexture() {
+	if (textureStale) {
+		if (texture.getSize() != sf::Vector2u(width, height)) {
+			texture.create(width, height);
+			texture.setSmooth(true);
+		}
+		texture.update(pixels.data());
+		textureStale = false;
+		dirty = sf::IntRect();
+	} else if (dirty.width > 0 && dirty.height > 0) {
+		// only the rows and columns that changed
+		const std::size_t rowBytes = static_cast<std::size_t>(dirty.width) * 4;
+		uploadScratch.resize(rowBytes * dirty.height);
+		for (int y = 0; y < dirty.height; y++) {
+			const std::uint8_t* source = pixels.data() + (static_cast<std::size_t>(dirty.top + y) * width + dirty.left) * 4;
+			std::copy(source, source + rowBytes, uploadScratch.data() + rowBytes * y);
+		}
+		texture.update(uploadScratch.data(), dirty.width, dirty.height, dirty.left, dirty.top);
+		dirty = sf::IntRect();
+	}
+	return texture;
+}
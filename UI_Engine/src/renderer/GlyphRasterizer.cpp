@@ -0,0 +1,142 @@
+#include "renderer/GlyphRasterizer.hpp"
+#include "utils/assetManager.hpp"
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+#include <cmath>
+
+GlyphRasterizer::GlyphRasterizer() {
+	FT_Library ftLibrary;
+	if (FT_Init_FreeType(&ftLibrary) == 0) {
+		library = ftLibrary;
+	}
+}
+
+GlyphRasterizer::~GlyphRasterizer() {
+	for (auto& [font, face] : faces) {
+		if (face.face) FT_Done_Face(static_cast<FT_Face>(face.face));
+	}
+	if (library) FT_Done_FreeType(static_cast<FT_Library>(library));
+}
+
+bool GlyphRasterizer::LoadFont(const sf::Font& font, const std::string& filename) {
+	if (!library) return false;
+
+	FT_Face ftFace;
+	if (FT_New_Face(static_cast<FT_Library>(library), filename.c_str(), 0, &ftFace) != 0) {
+		return false;
+	}
+	FT_Select_Charmap(ftFace, FT_ENCODING_UNICODE);
+
+	Face& face = faces[&font];
+	if (face.face) FT_Done_Face(static_cast<FT_Face>(face.face));
+	face.face = ftFace;
+	face.glyphs.clear();
+	return true;
+}
+
+bool GlyphRasterizer::HasFont(const sf::Font& font) {
+	return Resolve(font) != nullptr;
+}
+
+GlyphRasterizer::Face* GlyphRasterizer::Resolve(const sf::Font& font) {
+	auto it = faces.find(&font);
+	if (it != faces.end()) {
+		return it->second.face ? &it->second : nullptr;
+	}
+
+	std::string filename = AssetManager::get().getFontFile(font);
+	if (filename.empty() || !LoadFont(font, filename)) {
+		faces[&font];	// remember the miss
+		return nullptr;
+	}
+	return &faces[&font];
+}
+
+bool GlyphRasterizer::SetSize(Face& face, unsigned int characterSize) {
+	FT_Face ftFace = static_cast<FT_Face>(face.face);
+	if (ftFace->size->metrics.x_ppem == characterSize) return true;
+	return FT_Set_Pixel_Sizes(ftFace, 0, characterSize) == 0;
+}
+
+const RasterGlyph* GlyphRasterizer::GetGlyph(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize) {
+	Face* face = Resolve(font);
+	if (!face) return nullptr;
+
+	std::uint64_t key = (static_cast<std::uint64_t>(characterSize) << 32) | codePoint;
+	auto it = face->glyphs.find(key);
+	if (it != face->glyphs.end()) return &it->second;
+
+	RasterGlyph& glyph = face->glyphs[key];
+	FT_Face ftFace = static_cast<FT_Face>(face->face);
+	if (!SetSize(*face, characterSize)) return &glyph;
+
+	// same flags as sf::Font::loadGlyph
+	if (FT_Load_Char(ftFace, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0) return &glyph;
+
+	FT_Glyph glyphDesc;
+	if (FT_Get_Glyph(ftFace->glyph, &glyphDesc) != 0) return &glyph;
+
+	FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+	FT_BitmapGlyph bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(glyphDesc);
+	const FT_Bitmap& bitmap = bitmapGlyph->bitmap;
+
+	glyph.advance  = static_cast<float>(bitmapGlyph->root.advance.x >> 16);
+	glyph.lsbDelta = static_cast<int>(ftFace->glyph->lsb_delta);
+	glyph.rsbDelta = static_cast<int>(ftFace->glyph->rsb_delta);
+	glyph.left     = bitmapGlyph->left;
+	glyph.top      = -bitmapGlyph->top;
+	glyph.width    = bitmap.width;
+	glyph.height   = bitmap.rows;
+	glyph.coverage.resize(static_cast<std::size_t>(glyph.width) * glyph.height);
+
+	const unsigned char* row = bitmap.buffer;
+	for (unsigned int y = 0; y < glyph.height; y++) {
+		for (unsigned int x = 0; x < glyph.width; x++) {
+			std::uint8_t value;
+			if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO) {
+				value = ((row[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
+			} else {
+				value = row[x];
+			}
+			glyph.coverage[y * glyph.width + x] = value;
+		}
+		row += bitmap.pitch;
+	}
+
+	FT_Done_Glyph(glyphDesc);
+	return &glyph;
+}
+
+float GlyphRasterizer::GetKerning(const sf::Font& font, sf::Uint32 first, sf::Uint32 second, unsigned int characterSize) {
+	if (first == 0 || second == 0) return 0.f;
+
+	Face* face = Resolve(font);
+	if (!face) return 0.f;
+
+	// mirrors sf::Font::getKerning, including the autohinter's side bearing deltas
+	const RasterGlyph* firstGlyph  = GetGlyph(font, first, characterSize);
+	const RasterGlyph* secondGlyph = GetGlyph(font, second, characterSize);
+	FT_Face ftFace = static_cast<FT_Face>(face->face);
+	if (!SetSize(*face, characterSize)) return 0.f;
+
+	FT_Vector kerning;
+	kerning.x = kerning.y = 0;
+	if (FT_HAS_KERNING(ftFace)) {
+		FT_Get_Kerning(ftFace, FT_Get_Char_Index(ftFace, first), FT_Get_Char_Index(ftFace, second), FT_KERNING_UNFITTED, &kerning);
+	}
+	if (!FT_IS_SCALABLE(ftFace)) return static_cast<float>(kerning.x);
+
+	float delta = static_cast<float>(secondGlyph->lsbDelta - firstGlyph->rsbDelta);
+	return std::floor((delta + static_cast<float>(kerning.x) + 32) / static_cast<float>(1 << 6));
+}
+
+float GlyphRasterizer::GetLineSpacing(const sf::Font& font, unsigned int characterSize) {
+	Face* face = Resolve(font);
+	if (!face || !SetSize(*face, characterSize)) return 0.f;
+	return static_cast<float>(static_cast<FT_Face>(face->face)->size->metrics.height) / static_cast<float>(1 << 6);
+}
+
+void GlyphRasterizer::ClearGlyphs() {
+	for (auto& [font, face] : faces) face.glyphs.clear();
+}
@@ -0,0 +1,165 @@
+#include "renderer/RecordingRenderBackend.hpp"
+#include <algorithm>
+
+bool RenderCommand::operator==(const RenderCommand& other) const {
+	if (type != other.type || rect != other.rect || color != other.color) return false;
+
+	switch (type) {
+		case RenderCommandType::Rect:
+			return outlineColor == other.outlineColor && outlineThickness == other.outlineThickness;
+		case RenderCommandType::Triangle:
+			return points[0] == other.points[0] && points[1] == other.points[1] && points[2] == other.points[2];
+		case RenderCommandType::Text:
+			// text content is compared by the recorder, which owns the buffers
+			return font == other.font && characterSize == other.characterSize && textLength == other.textLength;
+		case RenderCommandType::PushClip:
+		case RenderCommandType::PopClip:
+		case RenderCommandType::BeginLayer:
+		case RenderCommandType::EndLayer:
+		case RenderCommandType::DrawLayer:
+			return true;
+	}
+	return true;
+}
+
+void RecordingRenderBackend::Begin() {
+	RenderBackend::Begin();
+	commands.clear();
+	textBuffer.clear();
+	clipDepth = 0;
+}
+
+void RecordingRenderBackend::FillRect(const sf::FloatRect& rect, const sf::Color& fill,
+									  float outlineThickness, const sf::Color& outline, const sf::RenderStates& states) {
+	RenderCommand command;
+	command.type = RenderCommandType::Rect;
+	command.rect = states.transform.transformRect(rect);
+	command.color = fill;
+	command.outlineColor = outline;
+	command.outlineThickness = outlineThickness;
+	commands.push_back(command);
+	stats.primitives++;
+}
+
+void RecordingRenderBackend::FillTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c,
+										  const sf::Color& color, const sf::RenderStates& states) {
+	RenderCommand command;
+	command.type = RenderCommandType::Triangle;
+	command.points[0] = states.transform.transformPoint(a);
+	command.points[1] = states.transform.transformPoint(b);
+	command.points[2] = states.transform.transformPoint(c);
+	command.color = color;
+	commands.push_back(command);
+	stats.primitives++;
+}
+
+void RecordingRenderBackend::DrawText(const TextRun& text, const sf::RenderStates& states) {
+	const std::string& string = text.getString();
+
+	RenderCommand command;
+	command.type = RenderCommandType::Text;
+	sf::Vector2f origin = states.transform.transformPoint(text.getPosition());
+	command.rect.left = origin.x;
+	command.rect.top = origin.y;
+	command.color = text.getFillColor();
+	command.font = text.getFont();
+	command.characterSize = text.getCharacterSize();
+	command.textOffset = static_cast<std::uint32_t>(textBuffer.size());
+	command.textLength = static_cast<std::uint32_t>(string.size());
+	// widget strings are single-byte (latin-1), widen them as is
+	for (unsigned char c : string) textBuffer.push_back(c);
+	commands.push_back(command);
+	stats.primitives++;
+}
+
+void RecordingRenderBackend::ClipChanged() {
+	RenderCommand command;
+	if (ClipDepth() > clipDepth) {
+		command.type = RenderCommandType::PushClip;
+		command.rect = GetClip();
+	} else {
+		command.type = RenderCommandType::PopClip;
+	}
+	clipDepth = ClipDepth();
+	commands.push_back(command);
+}
+
+bool RecordingRenderBackend::OnBeginLayer(const void* key, const sf::Vector2u& size) {
+	layers[key] = size;
+	RenderCommand command;
+	command.type = RenderCommandType::BeginLayer;
+	command.rect = sf::FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y));
+	commands.push_back(command);
+	return true;
+}
+
+void RecordingRenderBackend::OnEndLayer() {
+	RenderCommand command;
+	command.type = RenderCommandType::EndLayer;
+	commands.push_back(command);
+}
+
+void RecordingRenderBackend::DrawLayer(const void* key, const sf::FloatRect& rect, const sf::RenderStates& states) {
+	if (!HasLayer(key)) return;
+	RenderCommand command;
+	command.type = RenderCommandType::DrawLayer;
+	command.rect = states.transform.transformRect(rect);
+	command.color = sf::Color::White;
+	commands.push_back(command);
+	stats.primitives++;
+}
+
+long long RecordingRenderBackend::FirstDifference(const RecordingRenderBackend& other) const {
+	std::size_t count = std::min(commands.size(), other.commands.size());
+	for (std::size_t i = 0; i < count; i++) {
+		const RenderCommand& a = commands[i];
+		const RenderCommand& b = other.commands[i];
+		if (a != b) return static_cast<long long>(i);
+		if (a.type == RenderCommandType::Text && GetText(a) != other.GetText(b)) return static_cast<long long>(i);
+	}
+	if (commands.size() != other.commands.size()) return static_cast<long long>(count);
+	return -1;
+}
+
+std::uint64_t RecordingRenderBackend::Hash() const {
+	// fnv-1a over the fields that define what ends up on screen
+	std::uint64_t hash = 1469598103934665603ull;
+	auto mix = [&hash](const void* data, std::size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (std::size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	};
+	auto mixColor = [&mix](const sf::Color& c) { sf::Uint32 v = c.toInteger(); mix(&v, sizeof(v)); };
+	std::vector<const sf::Font*> fonts;
+
+	for (const auto& command : commands) {
+		mix(&command.type, sizeof(command.type));
+		mix(&command.rect, sizeof(command.rect));
+		mixColor(command.color);
+		switch (command.type) {
+			case RenderCommandType::Rect:
+				mixColor(command.outlineColor);
+				mix(&command.outlineThickness, sizeof(command.outlineThickness));
+				break;
+			case RenderCommandType::Triangle:
+				mix(command.points, sizeof(command.points));
+				break;
+			case RenderCommandType::Text: {
+				// fonts by order of first use, addresses change from run to run
+				auto seen = std::find(fonts.begin(), fonts.end(), command.font);
+				std::uint32_t fontId = static_cast<std::uint32_t>(seen - fonts.begin());
+				if (seen == fonts.end()) fonts.push_back(command.font);
+				mix(&fontId, sizeof(fontId));
+				mix(&command.characterSize, sizeof(command.characterSize));
+				std::u32string_view text = GetText(command);
+				mix(text.data(), text.size() * sizeof(char32_t));
+				break;
+			}
+			default:
+				break;
+		}
+	}
+	return hash;
+}
@@ -0,0 +1,243 @@
+#include "renderer/SFMLRenderBackend.hpp"
+#include "renderer/GlyphAtlas.hpp"
+#include <algorithm>
+#include <cmath>
+
+SFMLRenderBackend::SFMLRenderBackend() {
+	// queued glyph quads point into the atlas, they have to reach the target before an eviction reuses their texels
+	GlyphAtlas::get().AddEvictionListener(this, [this] { Flush(); });
+}
+
+SFMLRenderBackend::~SFMLRenderBackend() {
+	GlyphAtlas::get().RemoveEvictionListener(this);
+}
+
+void SFMLRenderBackend::Begin() {
+	RenderBackend::Begin();
+	for (std::size_t i = 0; i < batchCount; i++) {
+		batches[i].vertices.clear();
+		batches[i].items.clear();
+	}
+	batchCount = 0;
+}
+
+SFMLRenderBackend::Batch& SFMLRenderBackend::BatchFor(const sf::Texture* texture, const sf::FloatRect& bounds) {
+	// walk back over the queued batches; stop at the first one we'd have to draw on top of
+	std::size_t scanned = 0;
+	for (std::size_t i = batchCount; i-- > 0 && scanned < MaxLookback; scanned++) {
+		Batch& batch = batches[i];
+		bool sameClip = batch.clipped == HasClip() && (!batch.clipped || batch.clip == GetClip());
+		if (batch.texture == texture && sameClip) {
+			return batch;
+		}
+		if (batch.bounds.intersects(bounds)) {
+			bool overlaps = std::any_of(batch.items.begin(), batch.items.end(),
+				[&bounds](const sf::FloatRect& item) { return item.intersects(bounds); });
+			if (overlaps) break;
+		}
+	}
+
+	if (batchCount == batches.size()) batches.emplace_back();
+	Batch& batch = batches[batchCount++];
+	batch.texture = texture;
+	batch.premultiplied = submittingLayer;
+	batch.clipped = HasClip();
+	if (batch.clipped) batch.clip = GetClip();
+	batch.bounds = bounds;
+	return batch;
+}
+
+void SFMLRenderBackend::AddQuad(std::vector<sf::Vertex>& out, const sf::Transform& transform, const sf::FloatRect& rect,
+						 const sf::Color& color, const sf::FloatRect& uv) {
+	if (rect.width == 0.f || rect.height == 0.f) return;
+
+	sf::Vector2f p0 = transform.transformPoint(rect.left, rect.top);
+	sf::Vector2f p1 = transform.transformPoint(rect.left + rect.width, rect.top);
+	sf::Vector2f p2 = transform.transformPoint(rect.left, rect.top + rect.height);
+	sf::Vector2f p3 = transform.transformPoint(rect.left + rect.width, rect.top + rect.height);
+
+	sf::Vector2f t0(uv.left, uv.top);
+	sf::Vector2f t1(uv.left + uv.width, uv.top);
+	sf::Vector2f t2(uv.left, uv.top + uv.height);
+	sf::Vector2f t3(uv.left + uv.width, uv.top + uv.height);
+
+	out.emplace_back(p0, color, t0);
+	out.emplace_back(p1, color, t1);
+	out.emplace_back(p2, color, t2);
+	out.emplace_back(p2, color, t2);
+	out.emplace_back(p1, color, t1);
+	out.emplace_back(p3, color, t3);
+}
+
+void SFMLRenderBackend::Submit(const sf::Texture* texture, const std::vector<sf::Vertex>& vertices) {
+	if (vertices.empty()) return;
+
+	float minX = vertices[0].position.x, maxX = minX;
+	float minY = vertices[0].position.y, maxY = minY;
+	for (const auto& v : vertices) {
+		minX = std::min(minX, v.position.x);
+		maxX = std::max(maxX, v.position.x);
+		minY = std::min(minY, v.position.y);
+		maxY = std::max(maxY, v.position.y);
+	}
+	sf::FloatRect bounds(minX, minY, maxX - minX, maxY - minY);
+
+	// whatever the clip hides doesn't need drawing, nor counts towards overlap
+	if (HasClip() && !GetClip().intersects(bounds, bounds)) return;
+
+	Batch& batch = BatchFor(texture, bounds);
+	for (const auto& v : vertices) batch.vertices.append(v);
+	batch.items.push_back(bounds);
+
+	float right  = std::max(batch.bounds.left + batch.bounds.width, bounds.left + bounds.width);
+	float bottom = std::max(batch.bounds.top + batch.bounds.height, bounds.top + bounds.height);
+	batch.bounds.left   = std::min(batch.bounds.left, bounds.left);
+	batch.bounds.top    = std::min(batch.bounds.top, bounds.top);
+	batch.bounds.width  = right - batch.bounds.left;
+	batch.bounds.height = bottom - batch.bounds.top;
+
+	stats.primitives++;
+}
+
+void SFMLRenderBackend::FillRect(const sf::FloatRect& rect, const sf::Color& fill,
+						  float outlineThickness, const sf::Color& outline, const sf::RenderStates& states) {
+	const sf::Vector2f white = GlyphAtlas::WhiteTexel();
+	const sf::FloatRect uv(white, {0.f, 0.f});
+
+	scratch.clear();
+	if (fill.a > 0) AddQuad(scratch, states.transform, rect, fill, uv);
+
+	if (outlineThickness != 0.f && outline.a > 0) {
+		// same convention as sf::Shape: positive thickness grows outwards, negative inwards
+		float out = std::max(outlineThickness, 0.f);
+		float in  = std::max(-outlineThickness, 0.f);
+		sf::FloatRect outer(rect.left - out, rect.top - out, rect.width + out * 2.f, rect.height + out * 2.f);
+		sf::FloatRect inner(rect.left + in, rect.top + in, rect.width - in * 2.f, rect.height - in * 2.f);
+		float band = std::abs(outlineThickness);
+
+		AddQuad(scratch, states.transform, {outer.left, outer.top, outer.width, band}, outline, uv);
+		AddQuad(scratch, states.transform, {outer.left, inner.top + inner.height, outer.width, band}, outline, uv);
+		AddQuad(scratch, states.transform, {outer.left, inner.top, band, inner.height}, outline, uv);
+		AddQuad(scratch, states.transform, {inner.left + inner.width, inner.top, band, inner.height}, outline, uv);
+	}
+
+	Submit(&GlyphAtlas::get().GetTexture(), scratch);
+}
+
+void SFMLRenderBackend::FillTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c,
+							  const sf::Color& color, const sf::RenderStates& states) {
+	const sf::Vector2f white = GlyphAtlas::WhiteTexel();
+	scratch.clear();
+	scratch.emplace_back(states.transform.transformPoint(a), color, white);
+	scratch.emplace_back(states.transform.transformPoint(b), color, white);
+	scratch.emplace_back(states.transform.transformPoint(c), color, white);
+	Submit(&GlyphAtlas::get().GetTexture(), scratch);
+}
+
+void SFMLRenderBackend::DrawText(const TextRun& text, const sf::RenderStates& states) {
+	// the run keeps its glyph quads between frames, we only move them into place
+	const std::vector<sf::Vertex>& glyphs = text.getVertices();
+	if (glyphs.empty()) return;
+
+	sf::Transform transform = states.transform;
+	transform.translate(text.getPosition());
+
+	scratch.clear();
+	for (const auto& v : glyphs) {
+		scratch.emplace_back(transform.transformPoint(v.position), v.color, v.texCoords);
+	}
+	Submit(text.getTexture(), scratch);
+}
+
+void SFMLRenderBackend::End() {
+	Flush();
+}
+
+void SFMLRenderBackend::Flush() {
+	stats.batches += static_cast<int>(batchCount);
+	if (!target) {
+		batchCount = 0;
+		return;
+	}
+
+	const sf::View view = target->getView();
+	bool viewChanged = false;
+
+	for (std::size_t i = 0; i < batchCount; i++) {
+		const Batch& batch = batches[i];
+		if (batch.vertices.getVertexCount() == 0) continue;
+
+		// clip through a view whose viewport covers just the clip rect (sfml 2 has no scissor)
+		if (batch.clipped) {
+			sf::Vector2f targetSize(target->getSize());
+			sf::View clipView(batch.clip);
+			clipView.setViewport({batch.clip.left / targetSize.x, batch.clip.top / targetSize.y,
+								  batch.clip.width / targetSize.x, batch.clip.height / targetSize.y});
+			target->setView(clipView);
+			viewChanged = true;
+		} else if (viewChanged) {
+			target->setView(view);
+			viewChanged = false;
+		}
+
+		sf::RenderStates states = targetStates;
+		states.texture = batch.texture;
+		if (batch.premultiplied) states.blendMode = sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+		target->draw(batch.vertices, states);
+
+		stats.drawCalls++;
+		stats.vertices += static_cast<int>(batch.vertices.getVertexCount());
+	}
+
+	if (viewChanged) target->setView(view);
+
+	for (std::size_t i = 0; i < batchCount; i++) {
+		batches[i].vertices.clear();
+		batches[i].items.clear();
+	}
+	batchCount = 0;
+}
+
+bool SFMLRenderBackend::OnBeginLayer(const void* key, const sf::Vector2u& size) {
+	if (size.x == 0 || size.y == 0) return false;
+
+	auto& layer = layers[key];
+	if (!layer || layer->getSize() != size) {
+		layer = std::make_unique<sf::RenderTexture>();
+		if (!layer->create(size.x, size.y)) {
+			layers.erase(key);
+			return false;
+		}
+	}
+
+	// everything queued so far belongs underneath, it has to reach the old target first
+	Flush();
+	targetStack.emplace_back(target, targetStates);
+	target = layer.get();
+	targetStates = sf::RenderStates::Default;
+	target->setView(target->getDefaultView());
+	target->clear(sf::Color::Transparent);
+	return true;
+}
+
+void SFMLRenderBackend::OnEndLayer() {
+	Flush();
+	static_cast<sf::RenderTexture*>(target)->display();
+	target = targetStack.back().first;
+	targetStates = targetStack.back().second;
+	targetStack.pop_back();
+}
+
+void SFMLRenderBackend::DrawLayer(const void* key, const sf::FloatRect& rect, const sf::RenderStates& states) {
+	auto found = layers.find(key);
+	if (found == layers.end()) return;
+	const sf::Texture& texture = found->second->getTexture();
+
+	// the layer was drawn onto transparent black, so its colours are premultiplied
+	scratch.clear();
+	sf::Vector2f size(texture.getSize());
+	AddQuad(scratch, states.transform, rect, sf::Color::White, {0.f, 0.f, size.x, size.y});
+	submittingLayer = true;
+	Submit(&texture, scratch);
+	submittingLayer = false;
+}
@@ -0,0 +1,234 @@
+#include "renderer/SoftwareRenderBackend.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UI_SOFTWARE_SSE2 1
+#endif
+
+namespace {
+	// x / 255 for x in [0, 255 * 255], exact; same formula the simd path uses per lane
+	inline unsigned int div255(unsigned int x) {
+		return (x + 1 + (x >> 8)) >> 8;
+	}
+
+	// first pixel whose center is at or past coord
+	inline int pixelEdge(float coord) {
+		return static_cast<int>(std::ceil(coord - 0.5f));
+	}
+}
+
+void SoftwareRenderBackend::Resize(unsigned int w, unsigned int h) {
+	width = w;
+	height = h;
+	pixels.assign(static_cast<std::size_t>(width) * height * 4, 0);
+}
+
+void SoftwareRenderBackend::Begin() {
+	RenderBackend::Begin();
+
+	std::uint8_t rgba[4] = {clearColor.r, clearColor.g, clearColor.b, clearColor.a};
+	std::uint32_t packed;
+	std::memcpy(&packed, rgba, 4);
+	std::uint32_t* out = reinterpret_cast<std::uint32_t*>(pixels.data());
+	std::fill(out, out + static_cast<std::size_t>(width) * height, packed);
+}
+
+sf::Image SoftwareRenderBackend::ToImage() const {
+	sf::Image image;
+	if (width > 0 && height > 0) image.create(width, height, pixels.data());
+	return image;
+}
+
+sf::IntRect SoftwareRenderBackend::DrawableArea() const {
+	int left = 0, top = 0;
+	int right = static_cast<int>(width), bottom = static_cast<int>(height);
+	if (HasClip()) {
+		const sf::FloatRect& clip = GetClip();
+		left   = std::max(left, pixelEdge(clip.left));
+		top    = std::max(top, pixelEdge(clip.top));
+		right  = std::min(right, pixelEdge(clip.left + clip.width));
+		bottom = std::min(bottom, pixelEdge(clip.top + clip.height));
+	}
+	return sf::IntRect(left, top, right, bottom);	// note: right/bottom, not width/height
+}
+
+void SoftwareRenderBackend::BlendPixel(std::uint8_t* dst, const sf::Color& color, unsigned int alpha) {
+	// sf::BlendAlpha: rgb = src * a + dst * (1 - a), alpha = a + dst.a * (1 - a)
+	unsigned int inv = 255 - alpha;
+	dst[0] = static_cast<std::uint8_t>(div255(color.r * alpha + dst[0] * inv));
+	dst[1] = static_cast<std::uint8_t>(div255(color.g * alpha + dst[1] * inv));
+	dst[2] = static_cast<std::uint8_t>(div255(color.b * alpha + dst[2] * inv));
+	dst[3] = static_cast<std::uint8_t>(div255(255 * alpha + dst[3] * inv));
+}
+
+void SoftwareRenderBackend::BlendSpan(int x0, int x1, int y, const sf::Color& color) {
+	if (x1 <= x0 || color.a == 0) return;
+
+	std::uint8_t* dst = pixels.data() + (static_cast<std::size_t>(y) * width + x0) * 4;
+	int count = x1 - x0;
+	int i = 0;
+
+	if (color.a == 255) {
+		std::uint8_t rgba[4] = {color.r, color.g, color.b, color.a};
+		std::uint32_t packed;
+		std::memcpy(&packed, rgba, 4);
+#ifdef UI_SOFTWARE_SSE2
+		__m128i fill = _mm_set1_epi32(static_cast<int>(packed));
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), fill);
+		}
+#endif
+		for (; i < count; i++) std::memcpy(dst + i * 4, &packed, 4);
+		return;
+	}
+
+#ifdef UI_SOFTWARE_SSE2
+	// 4 pixels per step, widened to 16-bit lanes: (src * factor + dst * (255 - a)) / 255
+	const short a = color.a;
+	const __m128i src = _mm_set_epi16(static_cast<short>(255 * a), static_cast<short>(color.b * a),
+									  static_cast<short>(color.g * a), static_cast<short>(color.r * a),
+									  static_cast<short>(255 * a), static_cast<short>(color.b * a),
+									  static_cast<short>(color.g * a), static_cast<short>(color.r * a));
+	const __m128i inv  = _mm_set1_epi16(static_cast<short>(255 - a));
+	const __m128i one  = _mm_set1_epi16(1);
+	const __m128i zero = _mm_setzero_si128();
+
+	auto blend = [&](__m128i lanes) {
+		__m128i x = _mm_add_epi16(_mm_mullo_epi16(lanes, inv), src);
+		return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, one), _mm_srli_epi16(x, 8)), 8);
+	};
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+		__m128i lo = blend(_mm_unpacklo_epi8(px, zero));
+		__m128i hi = blend(_mm_unpackhi_epi8(px, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < count; i++) BlendPixel(dst + i * 4, color, color.a);
+}
+
+void SoftwareRenderBackend::FillPixelRect(const sf::FloatRect& rect, const sf::Color& color) {
+	if (color.a == 0) return;
+
+	sf::IntRect area = DrawableArea();
+	int x0 = std::max(area.left, pixelEdge(rect.left));
+	int x1 = std::min(area.width, pixelEdge(rect.left + rect.width));
+	int y0 = std::max(area.top, pixelEdge(rect.top));
+	int y1 = std::min(area.height, pixelEdge(rect.top + rect.height));
+
+	for (int y = y0; y < y1; y++) BlendSpan(x0, x1, y, color);
+}
+
+void SoftwareRenderBackend::FillRect(const sf::FloatRect& localRect, const sf::Color& fill,
+									 float outlineThickness, const sf::Color& outline, const sf::RenderStates& states) {
+	sf::FloatRect rect = states.transform.transformRect(localRect);
+	FillPixelRect(rect, fill);
+
+	if (outlineThickness != 0.f && outline.a > 0) {
+		// outline thickness scales with the transform, like sf::Shape
+		sf::Vector2f scale = states.transform.transformRect({0.f, 0.f, 1.f, 1.f}).getSize();
+		float out = std::max(outlineThickness, 0.f);
+		float in  = std::max(-outlineThickness, 0.f);
+		sf::FloatRect outer(rect.left - out * scale.x, rect.top - out * scale.y,
+							rect.width + out * scale.x * 2.f, rect.height + out * scale.y * 2.f);
+		sf::FloatRect inner(rect.left + in * scale.x, rect.top + in * scale.y,
+							rect.width - in * scale.x * 2.f, rect.height - in * scale.y * 2.f);
+		float bandX = std::abs(outlineThickness) * scale.x;
+		float bandY = std::abs(outlineThickness) * scale.y;
+
+		FillPixelRect({outer.left, outer.top, outer.width, bandY}, outline);
+		FillPixelRect({outer.left, inner.top + inner.height, outer.width, bandY}, outline);
+		FillPixelRect({outer.left, inner.top, bandX, inner.height}, outline);
+		FillPixelRect({inner.left + inner.width, inner.top, bandX, inner.height}, outline);
+	}
+	stats.primitives++;
+}
+
+void SoftwareRenderBackend::FillTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c,
+										 const sf::Color& color, const sf::RenderStates& states) {
+	stats.primitives++;
+	if (color.a == 0) return;
+
+	sf::Vector2f p[3] = {states.transform.transformPoint(a), states.transform.transformPoint(b), states.transform.transformPoint(c)};
+	sf::IntRect area = DrawableArea();
+
+	float minY = std::min({p[0].y, p[1].y, p[2].y});
+	float maxY = std::max({p[0].y, p[1].y, p[2].y});
+	int y0 = std::max(area.top, pixelEdge(minY));
+	int y1 = std::min(area.height, pixelEdge(maxY));
+
+	// scanline: intersect each row's center line with the three edges
+	for (int y = y0; y < y1; y++) {
+		float yc = static_cast<float>(y) + 0.5f;
+		float left = 1e30f, right = -1e30f;
+		for (int e = 0; e < 3; e++) {
+			const sf::Vector2f& s = p[e];
+			const sf::Vector2f& t = p[(e + 1) % 3];
+			if ((yc < s.y) == (yc < t.y)) continue;
+			float x = s.x + (yc - s.y) * (t.x - s.x) / (t.y - s.y);
+			left = std::min(left, x);
+			right = std::max(right, x);
+		}
+		if (right < left) continue;
+		BlendSpan(std::max(area.left, pixelEdge(left)), std::min(area.width, pixelEdge(right)), y, color);
+	}
+}
+
+void SoftwareRenderBackend::DrawText(const TextRun& text, const sf::RenderStates& states) {
+	stats.primitives++;
+
+	const sf::Font* font = text.getFont();
+	const sf::Color color = text.getFillColor();
+	if (!font || text.getString().empty() || color.a == 0 || !glyphs.HasFont(*font)) return;
+
+	const sf::String string(text.getString());
+	const unsigned int size = text.getCharacterSize();
+	const sf::Vector2f origin = states.transform.transformPoint(text.getPosition());
+	const sf::IntRect area = DrawableArea();
+
+	// same layout as sf::Text, with glyph data coming from FreeType instead of the font's pages
+	const RasterGlyph* space = glyphs.GetGlyph(*font, L' ', size);
+	float whitespaceWidth = space ? space->advance : 0.f;
+	float lineSpacing     = glyphs.GetLineSpacing(*font, size);
+
+	float x = 0.f;
+	float y = static_cast<float>(size);
+	sf::Uint32 prevChar = 0;
+
+	for (std::size_t i = 0; i < string.getSize(); i++) {
+		sf::Uint32 curChar = string[i];
+		if (curChar == L'\r') continue;
+
+		x += glyphs.GetKerning(*font, prevChar, curChar, size);
+		prevChar = curChar;
+
+		switch (curChar) {
+			case L' ':  x += whitespaceWidth;     continue;
+			case L'\t': x += whitespaceWidth * 4; continue;
+			case L'\n': y += lineSpacing; x = 0;  continue;
+		}
+
+		const RasterGlyph* glyph = glyphs.GetGlyph(*font, curChar, size);
+		if (!glyph) continue;
+
+		int gx = static_cast<int>(std::floor(origin.x + x + 0.5f)) + glyph->left;
+		int gy = static_cast<int>(std::floor(origin.y + y + 0.5f)) + glyph->top;
+		int cx0 = std::max(area.left, gx), cx1 = std::min(area.width, gx + static_cast<int>(glyph->width));
+		int cy0 = std::max(area.top, gy),  cy1 = std::min(area.height, gy + static_cast<int>(glyph->height));
+
+		for (int py = cy0; py < cy1; py++) {
+			const std::uint8_t* coverage = glyph->coverage.data() + static_cast<std::size_t>(py - gy) * glyph->width;
+			std::uint8_t* dst = pixels.data() + (static_cast<std::size_t>(py) * width) * 4;
+			for (int px = cx0; px < cx1; px++) {
+				unsigned int alpha = div255(coverage[px - gx] * color.a);
+				if (alpha) BlendPixel(dst + px * 4, color, alpha);
+			}
+		}
+
+		x += glyph->advance;
+	}
+}
@@ -0,0 +1,201 @@
+#include "renderer/TextMeasureCache.hpp"
+#include "renderer/GlyphAtlas.hpp"
+#include <SFML/System/String.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+TextMeasureCache& TextMeasureCache::get() {
+	static TextMeasureCache instance;
+	return instance;
+}
+
+TextMetrics TextMeasureCache::Measure(const sf::Font& font, unsigned int characterSize, std::string_view text, std::uint32_t style) {
+	FontKey fontKey{&font, characterSize, style};
+	std::size_t hash = std::hash<std::string_view>()(text);
+
+	auto found = index.find(EntryKey{fontKey, hash, text});
+	if (found != index.end()) {
+		stats.hits++;
+		entries.splice(entries.begin(), entries, found->second);
+		return found->second->metrics;
+	}
+
+	stats.misses++;
+	TextMetrics metrics = Compute(fontKey, text);
+	if (capacity == 0) return metrics;
+
+	entries.push_front(Entry{fontKey, hash, std::string(text), metrics});
+	index.emplace(EntryKey{fontKey, hash, entries.front().text}, entries.begin());
+	while (entries.size() > capacity) Evict();
+	return metrics;
+}
+
+void TextMeasureCache::Evict() {
+	const Entry& oldest = entries.back();
+	index.erase(EntryKey{oldest.font, oldest.hash, oldest.text});
+	entries.pop_back();
+	stats.evictions++;
+}
+
+void TextMeasureCache::setCapacity(std::size_t newCapacity) {
+	capacity = newCapacity;
+	while (entries.size() > capacity) Evict();
+}
+
+void TextMeasureCache::ForgetFont(const sf::Font& font) {
+	for (auto it = entries.begin(); it != entries.end(); ) {
+		if (it->font.font != &font) {
+			++it;
+			continue;
+		}
+		index.erase(EntryKey{it->font, it->hash, it->text});
+		it = entries.erase(it);
+	}
+	for (auto it = tables.begin(); it != tables.end(); ) {
+		if (it->first.font == &font) it = tables.erase(it);
+		else ++it;
+	}
+}
+
+void TextMeasureCache::Clear() {
+	index.clear();
+	entries.clear();
+	tables.clear();
+}
+
+TextMeasureCache::FontTable& TextMeasureCache::TableFor(const FontKey& key) {
+	auto found = tables.find(key);
+	if (found != tables.end()) return *found->second;
+
+	auto table = std::make_unique<FontTable>();
+	GlyphAtlas& atlas = GlyphAtlas::get();
+	// the atlas only rasterizes regular glyphs, like TextRun bold goes through the font
+	table->useAtlas = !(key.style & sf::Text::Bold) && atlas.HasFont(*key.font);
+	table->lineSpacing = table->useAtlas ? atlas.GetLineSpacing(*key.font, key.characterSize) : key.font->getLineSpacing(key.characterSize);
+	table->kerning.fill(std::numeric_limits<float>::quiet_NaN());
+	return *tables.emplace(key, std::move(table)).first->second;
+}
+
+TextMetrics TextMeasureCache::Compute(const FontKey& key, std::string_view text) {
+	FontTable& table = TableFor(key);
+	GlyphAtlas& atlas = GlyphAtlas::get();
+	const sf::Font& font = *key.font;
+	const unsigned int size = key.characterSize;
+	const bool bold = (key.style & sf::Text::Bold) != 0;
+	const float italicShear = (key.style & sf::Text::Italic) ? 0.209f : 0.f;	// same as sf::Text
+	bool tableOnly = true;
+
+	auto fetchGlyph = [&](sf::Uint32 codePoint, float& advance, sf::FloatRect& bounds) {
+		if (table.useAtlas) {
+			const sf::Glyph* glyph = atlas.GetGlyph(font, codePoint, size);
+			advance = glyph ? glyph->advance : 0.f;
+			bounds = glyph ? glyph->bounds : sf::FloatRect();
+		} else {
+			const sf::Glyph& glyph = font.getGlyph(codePoint, size, bold);
+			advance = glyph.advance;
+			bounds = glyph.bounds;
+		}
+	};
+	auto fetchKerning = [&](sf::Uint32 first, sf::Uint32 second) {
+		return table.useAtlas ? atlas.GetKerning(font, first, second, size) : font.getKerning(first, second, size, bold);
+	};
+	auto isAscii = [](sf::Uint32 c) { return c < AsciiCount; };
+
+	auto glyph = [&](sf::Uint32 codePoint, float& advance, sf::FloatRect& bounds) {
+		if (!isAscii(codePoint)) {
+			tableOnly = false;
+			fetchGlyph(codePoint, advance, bounds);
+			return;
+		}
+		std::size_t i = codePoint;
+		if (!table.known[i]) {
+			fetchGlyph(codePoint, table.advances[i], table.glyphBounds[i]);
+			table.known[i] = true;
+		}
+		advance = table.advances[i];
+		bounds = table.glyphBounds[i];
+	};
+	auto kerning = [&](sf::Uint32 first, sf::Uint32 second) {
+		if (first == 0) return 0.f;
+		if (!isAscii(first) || !isAscii(second)) {
+			tableOnly = false;
+			return fetchKerning(first, second);
+		}
+		float& pair = table.kerning[first * AsciiCount + second];
+		if (std::isnan(pair)) pair = fetchKerning(first, second);
+		return pair;
+	};
+
+	TextMetrics metrics;
+	metrics.lineSpacing = table.lineSpacing;
+	metrics.baseline = static_cast<float>(size);
+	if (text.empty()) return metrics;
+
+	// plain ascii is its own utf-32, anything else is converted the way TextRun does it
+	std::vector<sf::Uint32> converted;
+	bool ascii = std::all_of(text.begin(), text.end(), [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+	if (!ascii) {
+		sf::String utf32{std::string(text)};
+		converted.assign(utf32.begin(), utf32.end());
+	}
+	const std::size_t length = ascii ? text.size() : converted.size();
+	auto at = [&](std::size_t i) { return ascii ? static_cast<sf::Uint32>(static_cast<unsigned char>(text[i])) : converted[i]; };
+
+	// same walk as TextRun::ensureGeometry, minus the quads
+	float whitespaceWidth;
+	sf::FloatRect spaceBounds;
+	glyph(L' ', whitespaceWidth, spaceBounds);
+
+	float x = 0.f;
+	float y = static_cast<float>(size);
+	float minX = static_cast<float>(size), minY = static_cast<float>(size);
+	float maxX = 0.f, maxY = 0.f;
+	float widest = 0.f;
+	sf::Uint32 prevChar = 0;
+	metrics.lineCount = 1;
+
+	for (std::size_t i = 0; i < length; i++) {
+		sf::Uint32 curChar = at(i);
+		if (curChar == L'\r') continue;
+
+		x += kerning(prevChar, curChar);
+		prevChar = curChar;
+
+		if (curChar == L' ' || curChar == L'\t' || curChar == L'\n') {
+			minX = std::min(minX, x);
+			minY = std::min(minY, y);
+			switch (curChar) {
+				case L' ':  x += whitespaceWidth;     break;
+				case L'\t': x += whitespaceWidth * 4; break;
+				case L'\n':
+					widest = std::max(widest, x);
+					y += table.lineSpacing;
+					x = 0;
+					metrics.lineCount++;
+					break;
+			}
+			maxX = std::max(maxX, x);
+			maxY = std::max(maxY, y);
+			continue;
+		}
+
+		float advance;
+		sf::FloatRect bounds;
+		glyph(curChar, advance, bounds);
+		float left = bounds.left, top = bounds.top;
+		float right = bounds.left + bounds.width, bottom = bounds.top + bounds.height;
+		minX = std::min(minX, x + left - italicShear * bottom);
+		maxX = std::max(maxX, x + right - italicShear * top);
+		minY = std::min(minY, y + top);
+		maxY = std::max(maxY, y + bottom);
+
+		x += advance;
+	}
+
+	metrics.advance = std::max(widest, x);
+	metrics.bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+	if (tableOnly) stats.asciiMisses++;
+	return metrics;
+}
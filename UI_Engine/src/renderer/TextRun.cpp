@@ -0,0 +1,150 @@
+#include "renderer/TextRun.hpp"
+#include "renderer/GlyphAtlas.hpp"
+#include <algorithm>
+
+TextRun& TextRun::setString(const std::string& str) {
+	if (str != string) {
+		string = str;
+		geometryDirty = true;
+	}
+	return *this;
+}
+
+TextRun& TextRun::setFont(const FontHandle& f) {
+	if (f != font) {
+		font = f;
+		geometryDirty = true;
+	}
+	return *this;
+}
+
+TextRun& TextRun::setCharacterSize(unsigned int size) {
+	if (size != characterSize) {
+		characterSize = size;
+		geometryDirty = true;
+	}
+	return *this;
+}
+
+TextRun& TextRun::setFillColor(const sf::Color& color) {
+	if (color != fillColor) {
+		fillColor = color;
+		colorDirty = true;
+	}
+	return *this;
+}
+
+TextMetrics TextRun::measure() const {
+	if (!font) return TextMetrics();
+	return TextMeasureCache::get().Measure(*font, characterSize, string);
+}
+
+const sf::Texture* TextRun::getTexture() const {
+	if (!font) return nullptr;
+	ensureGeometry();
+	if (usesAtlas) return &GlyphAtlas::get().GetTexture();
+	return &font->getTexture(characterSize);
+}
+
+void TextRun::ensureGeometry() const {
+	GlyphAtlas& atlas = GlyphAtlas::get();
+	if (usesAtlas && atlasGeneration != atlas.GetGeneration()) geometryDirty = true;
+
+	if (!geometryDirty) {
+		if (colorDirty) {
+			for (auto& v : vertices) v.color = fillColor;
+			colorDirty = false;
+		}
+		return;
+	}
+	geometryDirty = false;
+	colorDirty = false;
+
+	// fetching a glyph can evict a shelf and hand its texels to the next one, under glyphs fetched
+	// earlier in this run. build again until a pass leaves the generation alone (a run too big for
+	// the whole atlas keeps its third try)
+	for (int attempt = 0; attempt < 3; attempt++) {
+		buildGeometry();
+		if (!usesAtlas || atlasGeneration == atlas.GetGeneration()) break;
+	}
+}
+
+void TextRun::buildGeometry() const {
+	GlyphAtlas& atlas = GlyphAtlas::get();
+	vertices.clear();
+	bounds = sf::FloatRect();
+	usesAtlas = false;
+	if (!font || string.empty()) return;
+	TotalRebuilds++;
+
+	usesAtlas = atlas.HasFont(*font);
+	atlasGeneration = atlas.GetGeneration();
+	auto getGlyph = [&](sf::Uint32 codePoint) -> const sf::Glyph& {
+		static const sf::Glyph empty;
+		if (!usesAtlas) return font->getGlyph(codePoint, characterSize, false);
+		const sf::Glyph* glyph = atlas.GetGlyph(*font, codePoint, characterSize);
+		return glyph ? *glyph : empty;
+	};
+	auto getKerning = [&](sf::Uint32 first, sf::Uint32 second) {
+		return usesAtlas ? atlas.GetKerning(*font, first, second, characterSize) : font->getKerning(first, second, characterSize);
+	};
+
+	// same layout as sf::Text (regular style, no outline)
+	const sf::String utf32(string);
+	float whitespaceWidth = getGlyph(L' ').advance;
+	float lineSpacing     = usesAtlas ? atlas.GetLineSpacing(*font, characterSize) : font->getLineSpacing(characterSize);
+	float x = 0.f;
+	float y = static_cast<float>(characterSize);
+
+	float minX = static_cast<float>(characterSize), minY = static_cast<float>(characterSize);
+	float maxX = 0.f, maxY = 0.f;
+	sf::Uint32 prevChar = 0;
+
+	for (std::size_t i = 0; i < utf32.getSize(); i++) {
+		sf::Uint32 curChar = utf32[i];
+		if (curChar == L'\r') continue;
+
+		x += getKerning(prevChar, curChar);
+		prevChar = curChar;
+
+		if (curChar == L' ' || curChar == L'\t' || curChar == L'\n') {
+			minX = std::min(minX, x);
+			minY = std::min(minY, y);
+			switch (curChar) {
+				case L' ':  x += whitespaceWidth;     break;
+				case L'\t': x += whitespaceWidth * 4; break;
+				case L'\n': y += lineSpacing; x = 0;  break;
+			}
+			maxX = std::max(maxX, x);
+			maxY = std::max(maxY, y);
+			continue;
+		}
+
+		const sf::Glyph& glyph = getGlyph(curChar);
+		const float padding = 1.f;
+		float left   = x + glyph.bounds.left - padding;
+		float top    = y + glyph.bounds.top - padding;
+		float right  = x + glyph.bounds.left + glyph.bounds.width + padding;
+		float bottom = y + glyph.bounds.top + glyph.bounds.height + padding;
+		float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+		float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+		float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+		float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+		vertices.emplace_back(sf::Vector2f(left, top), fillColor, sf::Vector2f(u1, v1));
+		vertices.emplace_back(sf::Vector2f(right, top), fillColor, sf::Vector2f(u2, v1));
+		vertices.emplace_back(sf::Vector2f(left, bottom), fillColor, sf::Vector2f(u1, v2));
+		vertices.emplace_back(sf::Vector2f(left, bottom), fillColor, sf::Vector2f(u1, v2));
+		vertices.emplace_back(sf::Vector2f(right, top), fillColor, sf::Vector2f(u2, v1));
+		vertices.emplace_back(sf::Vector2f(right, bottom), fillColor, sf::Vector2f(u2, v2));
+
+		minX = std::min(minX, x + glyph.bounds.left);
+		maxX = std::max(maxX, x + glyph.bounds.left + glyph.bounds.width);
+		minY = std::min(minY, y + glyph.bounds.top);
+		maxY = std::max(maxY, y + glyph.bounds.top + glyph.bounds.height);
+
+		x += glyph.advance;
+	}
+
+	bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
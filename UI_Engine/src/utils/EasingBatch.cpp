@@ -0,0 +1,127 @@
+#include "utils/EasingBatch.hpp"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EASING_BATCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace EasingBatch {
+
+#ifdef EASING_BATCH_SSE2
+namespace {
+
+	// 2^y for y <= 0: 2^round(y) straight into the exponent bits, times a polynomial for the rest in [-0.5, 0.5]
+	__m128 Exp2(__m128 y) {
+		y = _mm_max_ps(y, _mm_set1_ps(-126.f));
+		__m128i n = _mm_cvtps_epi32(y);
+		__m128 f = _mm_sub_ps(y, _mm_cvtepi32_ps(n));
+
+		__m128 p = _mm_set1_ps(1.5403530e-4f);
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.3333558e-3f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(9.6181291e-3f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(5.5504109e-2f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(2.4022651e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(6.9314718e-1f));
+		p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.f));
+
+		__m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+		return _mm_mul_ps(p, scale);
+	}
+
+	// sin(a): reduced to [-pi/2, pi/2] around the nearest multiple of pi (in two parts, for precision), odd polynomial there
+	__m128 Sin(__m128 a) {
+		__m128i k = _mm_cvtps_epi32(_mm_mul_ps(a, _mm_set1_ps(0.31830988618f)));
+		__m128 kf = _mm_cvtepi32_ps(k);
+		__m128 r = _mm_sub_ps(a, _mm_mul_ps(kf, _mm_set1_ps(3.140625f)));
+		r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(9.67653589793e-4f)));
+
+		__m128 r2 = _mm_mul_ps(r, r);
+		__m128 p = _mm_set1_ps(-2.5052108e-8f);
+		p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(2.7557319e-6f));
+		p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(-1.9841270e-4f));
+		p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(8.3333333e-3f));
+		p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(-1.6666667e-1f));
+		__m128 s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(p, r2), r));
+
+		// sin(r + k*pi) = (-1)^k sin(r)
+		__m128 sign = _mm_castsi128_ps(_mm_slli_epi32(k, 31));
+		return _mm_xor_ps(s, sign);
+	}
+
+	// easeInOutElastic on four values: both halves are a decaying 2^-|20x-10| times the same sine
+	__m128 Elastic(__m128 x) {
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const float c5 = (2 * 3.14159) / 4.5f;	// same constant as easeInOutElastic
+
+		__m128 u = _mm_sub_ps(_mm_mul_ps(x, _mm_set1_ps(20.f)), _mm_set1_ps(10.f));
+		__m128 absU = _mm_andnot_ps(_mm_set1_ps(-0.f), u);
+		__m128 decay = Exp2(_mm_sub_ps(zero, absU));
+		__m128 wave = Sin(_mm_mul_ps(_mm_sub_ps(u, _mm_set1_ps(1.125f)), _mm_set1_ps(c5)));
+
+		__m128 lower = _mm_cmplt_ps(x, half);
+		__m128 amplitude = _mm_or_ps(_mm_and_ps(lower, _mm_set1_ps(-0.5f)), _mm_andnot_ps(lower, half));
+		__m128 offset = _mm_andnot_ps(lower, one);
+		__m128 result = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(amplitude, decay), wave), offset);
+
+		// the end points are exact, like the scalar curve
+		result = _mm_andnot_ps(_mm_cmple_ps(x, zero), result);
+		__m128 atEnd = _mm_cmpge_ps(x, one);
+		return _mm_or_ps(_mm_and_ps(atEnd, one), _mm_andnot_ps(atEnd, result));
+	}
+
+}
+#endif
+
+void Ease(InterpolationType type, float* t, std::size_t count) {
+	std::size_t i = 0;
+#ifdef EASING_BATCH_SSE2
+	// the other curves are a table fetch each, see EasingCurves
+	if (type == InterpolationType::Linear || type == InterpolationType::easeInOutElastic) {
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(t + i), zero), one);
+			if (type == InterpolationType::easeInOutElastic) x = Elastic(x);
+			_mm_storeu_ps(t + i, x);
+		}
+	}
+#endif
+	for (; i < count; i++) t[i] = ::Ease(type, std::clamp(t[i], 0.f, 1.f));
+}
+
+void Lerp(const float* from, const float* to, const float* t, float* out, std::size_t count) {
+	std::size_t i = 0;
+#ifdef EASING_BATCH_SSE2
+	const __m128 one = _mm_set1_ps(1.f);
+	for (; i + 4 <= count; i += 4) {
+		__m128 w = _mm_loadu_ps(t + i);
+		__m128 value = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(from + i), _mm_sub_ps(one, w)), _mm_mul_ps(_mm_loadu_ps(to + i), w));
+		_mm_storeu_ps(out + i, value);
+	}
+#endif
+	for (; i < count; i++) out[i] = from[i] * (1.f - t[i]) + to[i] * t[i];
+}
+
+sf::Color ColorSoa::get(std::size_t i) const {
+	auto channel = [](float v) { return static_cast<sf::Uint8>(std::clamp(v, 0.f, 255.f) + 0.5f); };
+	return {channel(r[i]), channel(g[i]), channel(b[i]), channel(a[i])};
+}
+
+void Lerp(const Vector2Soa& from, const Vector2Soa& to, const float* t, Vector2Soa& out) {
+	out.resize(from.size());
+	Lerp(from.x.data(), to.x.data(), t, out.x.data(), from.size());
+	Lerp(from.y.data(), to.y.data(), t, out.y.data(), from.size());
+}
+
+void Lerp(const ColorSoa& from, const ColorSoa& to, const float* t, ColorSoa& out) {
+	out.resize(from.size());
+	Lerp(from.r.data(), to.r.data(), t, out.r.data(), from.size());
+	Lerp(from.g.data(), to.g.data(), t, out.g.data(), from.size());
+	Lerp(from.b.data(), to.b.data(), t, out.b.data(), from.size());
+	Lerp(from.a.data(), to.a.data(), t, out.a.data(), from.size());
+}
+
+}
@@ -0,0 +1,109 @@
+#include "utils/Interpolation.hpp"
+#include <algorithm>
+
+namespace {
+
+	constexpr float Pi = 3.14159265f;
+
+	float easeOutBounce(float x) {
+		const float n1 = 7.5625f, d1 = 2.75f;
+		if (x < 1.f / d1) return n1 * x * x;
+		if (x < 2.f / d1) { x -= 1.5f / d1; return n1 * x * x + 0.75f; }
+		if (x < 2.5f / d1) { x -= 2.25f / d1; return n1 * x * x + 0.9375f; }
+		x -= 2.625f / d1;
+		return n1 * x * x + 0.984375f;
+	}
+
+	// y at x on a css cubic-bezier: the curve's parameter for x is found with Newton steps
+	// (bisection when the slope is too flat for them), then y is read off at it
+	double SolveCubicBezier(double x1, double y1, double x2, double y2, double x) {
+		double cx = 3.0 * x1, bx = 3.0 * (x2 - x1) - cx, ax = 1.0 - cx - bx;
+		double cy = 3.0 * y1, by = 3.0 * (y2 - y1) - cy, ay = 1.0 - cy - by;
+		auto curveX = [&](double s) { return ((ax * s + bx) * s + cx) * s; };
+		auto slopeX = [&](double s) { return (3.0 * ax * s + 2.0 * bx) * s + cx; };
+
+		double s = x;
+		bool solved = false;
+		for (int i = 0; i < 8; i++) {
+			double error = curveX(s) - x;
+			if (std::abs(error) < 1e-9) { solved = true; break; }
+			double slope = slopeX(s);
+			if (std::abs(slope) < 1e-6) break;
+			s -= error / slope;
+		}
+		if (!solved) {
+			// x(s) is monotonic for x1, x2 in [0, 1]
+			double low = 0.0, high = 1.0;
+			s = x;
+			for (int i = 0; i < 64 && high - low > 1e-12; i++) {
+				double value = curveX(s);
+				if (value < x) low = s;
+				else high = s;
+				s = (low + high) * 0.5;
+			}
+		}
+		return ((ay * s + by) * s + cy) * s;
+	}
+
+}
+
+EasingCurves::EasingCurves() {
+	// in InterpolationType order
+	auto add = [this](std::function<float(float)> exact) { Add({std::move(exact)}); };
+	add([](float x) { return x; });
+	add(easeInOutElastic);
+	add([](float x) { return x * x; });
+	add([](float x) { return 1.f - (1.f - x) * (1.f - x); });
+	add([](float x) { return x < 0.5f ? 2.f * x * x : 1.f - std::pow(-2.f * x + 2.f, 2.f) / 2.f; });
+	add([](float x) { return x * x * x; });
+	add([](float x) { return 1.f - std::pow(1.f - x, 3.f); });
+	add([](float x) { return x < 0.5f ? 4.f * x * x * x : 1.f - std::pow(-2.f * x + 2.f, 3.f) / 2.f; });
+	add([](float x) { return -(std::cos(Pi * x) - 1.f) / 2.f; });
+	add([](float x) {
+		const float c1 = 1.70158f, c3 = c1 + 1.f;
+		return 1.f + c3 * std::pow(x - 1.f, 3.f) + c1 * std::pow(x - 1.f, 2.f);
+	});
+	add(easeOutBounce);
+
+	RegisterCubicBezier(0.25f, 0.1f, 0.25f, 1.f);
+	RegisterCubicBezier(0.42f, 0.f, 1.f, 1.f);
+	RegisterCubicBezier(0.f, 0.f, 0.58f, 1.f);
+	RegisterCubicBezier(0.42f, 0.f, 0.58f, 1.f);
+}
+
+InterpolationType EasingCurves::Add(Curve curve) {
+	Table& table = tables.emplace_back();
+	for (int i = 0; i <= Resolution; i++) table[i] = curve.exact(static_cast<float>(i) / Resolution);
+	// the ends are exact whatever the curve rounds to
+	table[0] = 0.f;
+	table[Resolution] = 1.f;
+
+	curves.push_back(std::move(curve));
+	return static_cast<InterpolationType>(curves.size() - 1);
+}
+
+InterpolationType EasingCurves::RegisterCubicBezier(float x1, float y1, float x2, float y2) {
+	x1 = std::clamp(x1, 0.f, 1.f);
+	x2 = std::clamp(x2, 0.f, 1.f);
+	for (std::size_t i = 0; i < curves.size(); i++) {
+		const CubicBezier& p = curves[i].points;
+		if (curves[i].bezier && p.x1 == x1 && p.y1 == y1 && p.x2 == x2 && p.y2 == y2) return static_cast<InterpolationType>(i);
+	}
+
+	Curve curve;
+	curve.bezier = true;
+	curve.points = {x1, y1, x2, y2};
+	curve.exact = [x1, y1, x2, y2](float x) { return static_cast<float>(SolveCubicBezier(x1, y1, x2, y2, x)); };
+	return Add(std::move(curve));
+}
+
+InterpolationType EasingCurves::RegisterEasing(std::function<float(float)> curve) {
+	return Add({std::move(curve)});
+}
+
+float EasingCurves::EaseExact(InterpolationType type, float t) const {
+	std::size_t index = static_cast<std::size_t>(type);
+	t = std::clamp(t, 0.f, 1.f);
+	if (index >= curves.size()) return t;
+	return curves[index].exact(t);
+}
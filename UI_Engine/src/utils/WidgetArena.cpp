@@ -0,0 +1,46 @@
+#include "utils/WidgetArena.hpp"
+#include <new>
+
+WidgetArena::WidgetArena(std::size_t blockSize)
+	: blockSize(RoundUp(blockSize)) {}
+
+WidgetArena::~WidgetArena() = default;
+
+void* WidgetArena::Allocate(std::size_t size, std::size_t alignment) {
+	// odd sizes and alignments go straight to the heap
+	if (!Fits(size, alignment)) return ::operator new(size, std::align_val_t(alignment));
+
+	live++;
+	std::size_t rounded = RoundUp(size);
+	std::size_t slot = rounded / Granularity;
+	if (slot < freeLists.size() && freeLists[slot]) {
+		FreeNode* node = freeLists[slot];
+		freeLists[slot] = node->next;
+		return node;
+	}
+
+	if (remaining < rounded) {
+		// whatever is left of the old block is dropped, it's less than one object
+		blocks.push_back(std::make_unique<std::byte[]>(blockSize));
+		cursor = blocks.back().get();
+		remaining = blockSize;
+	}
+	void* pointer = cursor;
+	cursor += rounded;
+	remaining -= rounded;
+	return pointer;
+}
+
+void WidgetArena::Deallocate(void* pointer, std::size_t size, std::size_t alignment) {
+	if (!Fits(size, alignment)) {
+		::operator delete(pointer, std::align_val_t(alignment));
+		return;
+	}
+
+	live--;
+	std::size_t slot = RoundUp(size) / Granularity;
+	if (slot >= freeLists.size()) freeLists.resize(slot + 1, nullptr);
+	FreeNode* node = static_cast<FreeNode*>(pointer);
+	node->next = freeLists[slot];
+	freeLists[slot] = node;
+}
@@ -1,4 +1,5 @@
 #include "utils/assetManager.hpp"
+#include "renderer/TextMeasureCache.hpp"
 #include <iostream>
 // Locate assets/ at static init time
 fs::path AssetManager::asset_dir = [] {
@@ -36,17 +37,42 @@ sf::Texture& AssetManager::getTexture(const std::string& filename) {
 }
 
 sf::Font& AssetManager::getFont(const std::string& filename) {
+    return const_cast<sf::Font&>(*getFontHandle(filename));
+}
+
+FontHandle AssetManager::getFontHandle(const std::string& filename) {
     auto it = fonts.find(filename);
     if (it != fonts.end()) {
-        return *it->second;
+        return it->second;
     }
 
-    auto font = std::make_unique<sf::Font>();
+    auto font = std::make_shared<sf::Font>();
     if (!font->loadFromFile((asset_dir / filename).string())) {
         throw std::runtime_error("Failed to load font: " + filename);
     }
 
-    sf::Font& ref = *font;
-    fonts[filename] = std::move(font);
-    return ref;
+    fonts[filename] = font;
+    return font;
+}
+
+std::string AssetManager::getFontFile(const sf::Font& font) const {
+    for (const auto& [filename, cached] : fonts) {
+        if (cached.get() == &font) {
+            return (asset_dir / filename).string();
+        }
+    }
+    return "";
+}
+
+FontHandle AssetManager::wrapFont(const sf::Font& font) {
+    // one of ours: share it (and its pages, and the atlas path through getFontFile)
+    for (const auto& [filename, cached] : get().fonts) {
+        if (cached.get() == &font) return cached;
+    }
+
+    // measurements are keyed by font address, a later font at the same address mustn't inherit them
+    return FontHandle(new sf::Font(font), [](const sf::Font* copy) {
+        TextMeasureCache::get().ForgetFont(*copy);
+        delete copy;
+    });
 }
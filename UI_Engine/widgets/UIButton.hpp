@@ -28,66 +28,81 @@ public:
 		return *this;
 	}
     UIButton& setSize(const sf::Vector2f& size) {
-        e_size = size;
+        e_requestedSize = size;
 		markLayoutDirty();
         return *this;
     }
     UIButton& setFillColor(const sf::Color& color) {
         e_fillcolor = color;
+        markPaintDirty();
         return *this;
     }
     UIButton& setOutlineColor(const sf::Color& color) {
         e_outlinecolor = color;
+        markPaintDirty();
         return *this;
     }
     UIButton& setOutlineThickness(float t) {
         e_outlineThickness = t;
+        markPaintDirty();
         return *this;
     }
     UIButton& setTextColor(const sf::Color& color) {
         textColor = color;
         label.setFillColor(color);
+        markPaintDirty();
         return *this;
     }
     UIButton& setLabel(const std::string& str) {
         labelText = str;
         label.setString(labelText);
+        markPaintDirty();
         return *this;
     }
     UIButton& setFont(const sf::Font& f) {
-        font = f;
-        label.setFont(f);
+        font = AssetManager::wrapFont(f);
+        label.setFont(font);
+        markPaintDirty();
+        return *this;
+    }
+    UIButton& setFont(FontHandle f) {
+        font = std::move(f);
+        label.setFont(font);
+        markPaintDirty();
         return *this;
     }
     UIButton& setTextSize(unsigned int size) {
         textSize = size;
         label.setCharacterSize(size);
+        markPaintDirty();
         return *this;
     }
     // hover effect configuration	(honestly idk why would i need this, but i know i will)
     UIButton& setHoverDarken(float percent) {
         hoverDarken = percent;
+        markPaintDirty();
         return *this;
     }
 
 	UIButton& setEnable(bool en) {
-		enabled = en;
+		SetEnabled(en);
 		return *this;
 	}
 
 	UIButton& setVisible(bool vis) {
-		visible = vis;
+		SetVisible(vis);
 		return *this;
 	}
 
-	UIButton& setOnTick(std::function<void(UIButton&)> cb) { onTick = std::move(cb); return *this; }
+	UIButton& setOnTick(std::function<void(UIButton&)> cb) { onTick = std::move(cb); RefreshTick(); return *this; }
+	bool WantsTick() const override { return static_cast<bool>(onTick); }
 
 	void Update(const float dt) override {
 		if(!enabled) return;
 		if(onTick) onTick(*this);
 	}
 
-    void DrawSelf(sf::RenderTarget& target, sf::RenderStates states) override {
+    void DrawSelf(RenderBackend& renderer, sf::RenderStates states) override {
 		if(!visible) return;
 
         sf::Color drawColor = e_fillcolor;
@@ -103,74 +118,24 @@ public:
             drawColor.g = static_cast<sf::Uint8>(drawColor.g * (1.f - hoverDarken));
             drawColor.b = static_cast<sf::Uint8>(drawColor.b * (1.f - hoverDarken));
         }
-        sf::RectangleShape rect(e_size);
-        rect.setPosition(e_position);
-        rect.setFillColor(drawColor);
-        rect.setOutlineColor(e_outlinecolor);
-        rect.setOutlineThickness(e_outlineThickness);
-        // scale effect when pressed
+        sf::FloatRect body(e_position, e_size);
+        float thickness = e_outlineThickness;
+        // scale effect when pressed (0.99 scale around a slightly offset origin)
         if (pressed) {
-            rect.setScale(0.99f, 0.99f);
-            rect.setOrigin(e_size.x * 0.0051f , e_size.y * 0.0051f);
-        } else {
-            rect.setScale(1.f, 1.f);
-            rect.setOrigin(0, 0);
+            body = sf::FloatRect(e_position - e_size * 0.0051f * 0.99f, e_size * 0.99f);
+            thickness *= 0.99f;
         }
-        target.draw(rect, states);
-        // Center label
+        renderer.FillRect(body, drawColor, thickness, e_outlinecolor, states);
+        // Center label (no-ops unless something changed, the glyphs stay cached)
         label.setFont(font);
         label.setCharacterSize(textSize);
         label.setFillColor(textColor);
         label.setString(labelText);
         label.setPosition(e_position.x + (e_size.x - label.getLocalBounds().width) / 2.f,
                             e_position.y + (e_size.y - label.getLocalBounds().height) / 2.f - label.getLocalBounds().top);
-        target.draw(label, states);
+        renderer.DrawText(label, states);
     }
 
-    void CalculateLayout() override {
-
-		if(layoutType == LayoutType::Static) {
-			e_position = e_offset;
-		} else if(layoutType == LayoutType::Relative) {
-        	if (auto parentPtr = parent.lock()) {
-				e_position = parentPtr->e_position + parentPtr->e_padding + e_offset;
-			} else {
-				e_position = e_offset;
-			}
-		} else if(layoutType == LayoutType::Percent) {
-			if (auto parentPtr = parent.lock()) {
-				sf::Vector2f parentSize = parentPtr->e_size - parentPtr->e_padding * 2.0f;
-				e_position.x = parentPtr->e_position.x + parentPtr->e_padding.x + (parentSize.x * (e_offset.x / 100.f));
-				e_position.y = parentPtr->e_position.y + parentPtr->e_padding.y + (parentSize.y * (e_offset.y / 100.f));
-			}
-		} else if(layoutType == LayoutType::Anchor) {
-			e_position = e_offset;
-		}
-		interpolated_position = e_position;
-
-		// Calculate size based on sizeType
- 		if (sizeType == SizeType::FitContent) {
-			std::runtime_error("FitContent size type is not supported for UIButton.");
-		} else if (sizeType == SizeType::FillParent) {
-			// Fill parent logic (e.g., match parent's size)
-			if (auto parentPtr = parent.lock()) {
-				e_size = parentPtr->e_size-parentPtr->e_padding/0.5f - e_offset;
-			}
-		} else if (sizeType == SizeType::Percent) {
-			// Percent size logic (e.g., based on parent's size)
-			if (auto parentPtr = parent.lock()) {
-				auto parentArea = parentPtr->e_size - parentPtr->e_padding/0.5f;
-				e_size.x = parentArea.x * (e_size.x / 100.f);
-				e_size.y = parentArea.y * (e_size.y / 100.f);
-			}
-		}
-
-		label.setFont(font);
-		label.setCharacterSize(textSize);
-		label.setFillColor(textColor);
-		label.setString(labelText);
-
-    }
 
 	// lambda setters for event handlers
     UIButton& setOnClick(std::function<void()> cb) {
@@ -201,14 +166,17 @@ public:
             bool hoveredNow = contains(event.mousePos);
             if (hoveredNow && !hovered) {
                 hovered = true;
+                markPaintDirty();
                 if (onHover) onHover();
             } else if (!hoveredNow && hovered) {
                 hovered = false;
+                markPaintDirty();
                 if (onLeave) onLeave();
             }
         } else if (event.type == UIEventType::MouseDown && contains(event.mousePos)) {
             if (!pressed) { // Only trigger onPress on the first press
                 pressed = true;
+                markPaintDirty();
                 if (onPress) onPress();
             }
         } else if (event.type == UIEventType::MouseUp) {
@@ -216,6 +184,7 @@ public:
                 if (onClick) onClick();
             }
             if (pressed && onRelease) onRelease();
+            if (pressed) markPaintDirty();
             pressed = false;
         }
     }
@@ -226,8 +195,8 @@ private:
                pt.y >= e_position.y && pt.y <= e_position.y + e_size.y;
     }
     std::string labelText = "Button";
-    sf::Text label;
-    sf::Font font = AssetManager::get().getFont("fonts/arial.ttf");
+    TextRun label;
+    FontHandle font = AssetManager::get().getFontHandle("fonts/arial.ttf");
     sf::Color textColor = sf::Color::Black;
     float e_outlineThickness = 2.f;
     sf::Color e_outlinecolor = sf::Color::Black;
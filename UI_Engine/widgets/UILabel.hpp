@@ -2,6 +2,11 @@
 #include "core/UIElement.hpp"
 #include <SFML/Graphics/Text.hpp>
 #include <string>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <cctype>
+#include <algorithm>
 
 
 class UILabel : public UILeaf {
@@ -17,12 +22,13 @@ public:
         return *this;
     }
     UILabel& setSize(const sf::Vector2f& size) {
-        e_size = size;
+        e_requestedSize = size;
 		markLayoutDirty();
         return *this;
     }
     UILabel& setFillColor(const sf::Color& color) {
         e_fillcolor = color;
+        markPaintDirty();
         return *this;
     }
     UILabel& setAnchor(LayoutAnchor anch) {
@@ -48,141 +54,189 @@ public:
     UILabel& setBorder(float thickness, const sf::Color& color) {
         borderThickness = thickness;
         borderColor = color;
+        markPaintDirty();
         return *this;
     }
     // --- Widget-specific setters ---
     UILabel& setText(const std::string& str) {
-        text.setString(str);
+        if (str == labelText) return *this;
         labelText = str;
+        displayDirty = true;
+        if (sizeType == SizeType::FitContent) markLayoutDirty();
+        else markPaintDirty();
         return *this;
     }
     UILabel& setFont(const sf::Font& f) {
-        font = f;
+        font = AssetManager::wrapFont(f);
+        if (sizeType == SizeType::FitContent) markLayoutDirty();
+        else markPaintDirty();
+        return *this;
+    }
+    UILabel& setFont(FontHandle f) {
+        font = std::move(f);
+        if (sizeType == SizeType::FitContent) markLayoutDirty();
+        else markPaintDirty();
         return *this;
     }
     UILabel& setTextSize(unsigned int size) {
         textSize = size;
         text.setCharacterSize(size);
+        if (sizeType == SizeType::FitContent) markLayoutDirty();
+        else markPaintDirty();
         return *this;
     }
     UILabel& setTextColor(const sf::Color& color) {
         textColor = color;
         text.setFillColor(color);
+        markPaintDirty();
         return *this;
     }
 
 	UILabel& setEnable(bool en) {
-		enabled = en;
+		SetEnabled(en);
 		return *this;
 	}
 
 	UILabel& setVisible(bool vis) {
-		visible = vis;
+		SetVisible(vis);
 		return *this;
 	}
 
 	UILabel& setDecimal(int dec) {
 		decimals = std::max(0, std::min(dec, 6));
+		displayDirty = true;
+		if (sizeType == SizeType::FitContent) markLayoutDirty();
+		else markPaintDirty();
+		return *this;
+	}
+
+	// show *bound through a printf format instead of the label text, e.g. setBoundValue(&fps, "%.0f fps").
+	// only reformatted when the value changes, into buffers that are reused, so no per-frame allocations.
+	// the format must hold exactly one floating point conversion (%f, %e, %g or %a), std::invalid_argument otherwise
+	UILabel& setBoundValue(const float* bound, const std::string& format = "%.2f") {
+		if (!isFloatFormat(format)) throw std::invalid_argument("UILabel::setBoundValue: format needs exactly one %f/%e/%g/%a: " + format);
+		boundValue = bound;
+		boundFormat = format;
+		displayDirty = true;
+		if (sizeType == SizeType::FitContent) markLayoutDirty();
+		else markPaintDirty();
+		RefreshTick();
 		return *this;
 	}
 
 	UILabel& setOnTick(std::function<void(const float)> cb) {
 		onTick = std::move(cb);
+		RefreshTick();
 		return *this;
 	}
+	// a bound value is only polled, it can't schedule anything by itself
+	bool WantsTick() const override { return onTick || boundValue; }
+	float NextTickIn() const override { return onTick ? 0.f : std::numeric_limits<float>::infinity(); }
 
 	void Update(const float dt) override {
 		if(!enabled) return;
 
 		if(onTick) onTick(dt);
+		// a new value is measured in this frame's layout pass, before it's drawn
+		if (boundValue && !displayDirty && *boundValue != lastBoundValue) {
+			displayDirty = true;
+			if (sizeType == SizeType::FitContent) markLayoutDirty();
+			else markPaintDirty();
+		}
 	}
 
-	void DrawSelf(sf::RenderTarget& target, sf::RenderStates states) override {
+	void DrawSelf(RenderBackend& renderer, sf::RenderStates states) override {
 		if (!visible) return;
 
 		// Draw background (if alpha > 0)
 		if (e_fillcolor.a > 0) {
-			sf::RectangleShape rect(e_size);
-			rect.setPosition(e_position);
-			rect.setFillColor(e_fillcolor);
-			rect.setOutlineColor(borderColor);
-			rect.setOutlineThickness(borderThickness);
-			target.draw(rect, states);
+			renderer.FillRect({e_position, e_size}, e_fillcolor, borderThickness, borderColor, states);
 		}
 
-		std::string displayText="";
-		for(auto counter=0; counter<labelText.size(); counter++){
-			if(labelText.at(counter) != '.'){
-				displayText.push_back(labelText.at(counter));
-			}else{
-				if(decimals > 0){
-					displayText.push_back(labelText.at(counter));
-					for(auto i=0; i<decimals; i++){
-						if(!std::isdigit(labelText.at(counter+1))) break;
-
-						counter++;
-						char ch = labelText.at(counter);
-						displayText.push_back(ch);
-					}
-				}
-				counter++;
-				while(counter<labelText.size()){
-					if(std::isdigit(labelText.at(counter)))	counter++;
-					else {counter--; break;}
-				}
+		// === Draw text ===
+		refreshDisplayText();
+		text.setPosition(e_position + e_padding);
+
+		renderer.DrawText(text, states);
+	}
+
+protected:
+    sf::Vector2f MeasureContent(const sf::Vector2f& available) override {
+        refreshDisplayText();
+		sf::FloatRect bounds = text.measure().bounds;
+        return {bounds.width + 15, bounds.height + 20};
+    }
+
+private:
+	// one conversion taking a double, with flags, width and precision but no '*' or length modifier
+	static bool isFloatFormat(const std::string& format) {
+		int conversions = 0;
+		for (std::size_t i = 0; i < format.size(); i++) {
+			if (format[i] != '%') continue;
+			if (++i < format.size() && format[i] == '%') continue;
+			while (i < format.size() && std::strchr("-+ #0", format[i])) i++;
+			while (i < format.size() && std::isdigit(static_cast<unsigned char>(format[i]))) i++;
+			if (i < format.size() && format[i] == '.') {
+				i++;
+				while (i < format.size() && std::isdigit(static_cast<unsigned char>(format[i]))) i++;
 			}
+			if (i >= format.size() || !std::strchr("fFeEgGaA", format[i])) return false;
+			conversions++;
 		}
+		return conversions == 1;
+	}
 
-		// === Draw text ===
+	// rebuilds the shown string when the label text, decimals or bound value changed; true if it did
+	bool refreshDisplayText() {
 		text.setFont(font);
 		text.setCharacterSize(textSize);
 		text.setFillColor(textColor);
-		text.setPosition(e_position + e_padding);
-		text.setString(displayText);
 
-		target.draw(text, states);
-	}
+		if (boundValue) {
+			if (!displayDirty && *boundValue == lastBoundValue) return false;
+			displayDirty = false;
+			lastBoundValue = *boundValue;
 
-    void CalculateLayout() override {
-        if(layoutType == LayoutType::Static) {
-            e_position = e_offset;
-        } else if(layoutType == LayoutType::Relative) {
-            if (auto parentPtr = parent.lock()) {
-                e_position = parentPtr->e_position + parentPtr->e_padding + e_offset;
-            } else {
-                e_position = e_offset;
-            }
-        } else if(layoutType == LayoutType::Percent) {
-            if (auto parentPtr = parent.lock()) {
-                sf::Vector2f parentSize = parentPtr->e_size - parentPtr->e_padding * 2.0f;
-                e_position.x = parentPtr->e_position.x + parentPtr->e_padding.x + (parentSize.x * (e_offset.x / 100.f));
-                e_position.y = parentPtr->e_position.y + parentPtr->e_padding.y + (parentSize.y * (e_offset.y / 100.f));
-            }
-        } else if(layoutType == LayoutType::Anchor) {
-            e_position = e_offset;
-        }
-
-
-        if (sizeType == SizeType::FillParent) {
-            if (auto parentPtr = parent.lock()) {
-                e_size = parentPtr->e_size - parentPtr->e_padding/0.5f - e_offset;
-            }
-        } else if (sizeType == SizeType::Percent) {
-            if (auto parentPtr = parent.lock()) {
-                auto parentArea = parentPtr->e_size - parentPtr->e_padding/0.5f;
-                e_size.x = parentArea.x * (e_size.x / 100.f);
-                e_size.y = parentArea.y * (e_size.y / 100.f);
-            }
-        } else if (sizeType == SizeType::FitContent) {
-            e_size.x = text.getLocalBounds().width + 15;
-            e_size.y = text.getLocalBounds().height + 20;
-        }
-    }
+			char buffer[64];
+			int length = std::snprintf(buffer, sizeof(buffer), boundFormat.c_str(), static_cast<double>(lastBoundValue));
+			displayText.assign(buffer, static_cast<std::size_t>(std::clamp(length, 0, static_cast<int>(sizeof(buffer)) - 1)));
+			text.setString(displayText);
+			return true;
+		}
+
+		if (!displayDirty) return false;
+		displayDirty = false;
+
+		// keep at most `decimals` digits after each decimal point
+		displayText.clear();
+		for (std::size_t i = 0; i < labelText.size(); i++) {
+			char ch = labelText[i];
+			if (ch != '.') {
+				displayText.push_back(ch);
+				continue;
+			}
+			if (decimals > 0) displayText.push_back(ch);
+			unsigned int kept = 0;
+			while (i + 1 < labelText.size() && std::isdigit(static_cast<unsigned char>(labelText[i + 1]))) {
+				i++;
+				if (kept < decimals) {
+					displayText.push_back(labelText[i]);
+					kept++;
+				}
+			}
+		}
+		text.setString(displayText);
+		return true;
+	}
 
-private:
     std::string labelText = "Label";
-    sf::Text text;
-    sf::Font font = AssetManager::get().getFont("fonts/arial.ttf");
+    std::string displayText;
+    bool displayDirty = true;
+    const float* boundValue = nullptr;
+    std::string boundFormat;
+    float lastBoundValue = 0.f;
+    TextRun text;
+    FontHandle font = AssetManager::get().getFontHandle("fonts/arial.ttf");
     sf::Color textColor = sf::Color::Black;
     unsigned int textSize = 18;
 	unsigned int decimals = 2;
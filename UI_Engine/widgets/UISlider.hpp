@@ -1,54 +1,59 @@
 #pragma once
 #include "core/UIElement.hpp"
+#include "core/DamageRegion.hpp"
 #include <SFML/Graphics.hpp>
 #include <functional>
 #include <string>
-#include <iomanip>
-#include <sstream>
-#include <limits> 
+#include <cstdio>
+#include <limits>
 class UISlider : public UILeaf {
 public:
-    UISlider(const std::string& name = defaultName()) : UILeaf(name) {}
+    UISlider(const std::string& name = defaultName()) : UILeaf(name) { refreshValueText(); }
 
     // --- Standard setters (copied from StandardLeaf/UILeaf for consistency) ---
     UISlider& setOffset(const sf::Vector2f& pos) { e_offset = pos; markLayoutDirty(); return *this; }
-    UISlider& setSize(const sf::Vector2f& size) { e_size = size; markLayoutDirty(); return *this; }
-    UISlider& setFillColor(const sf::Color& color) { e_fillcolor = color; return *this; }
-    UISlider& setBorder(float thickness, const sf::Color& color) { borderThickness = thickness; borderColor = color; return *this; }
-    UISlider& setFont(const sf::Font& f) { font = f; return *this; }
-    UISlider& setTextSize(unsigned int size) { textSize = size; return *this; }
-    UISlider& setTextColor(const sf::Color& color) { textColor = color; return *this; }
+    UISlider& setSize(const sf::Vector2f& size) { e_requestedSize = size; markLayoutDirty(); return *this; }
+    UISlider& setFillColor(const sf::Color& color) { e_fillcolor = color; markPaintDirty(); return *this; }
+    UISlider& setBorder(float thickness, const sf::Color& color) { borderThickness = thickness; borderColor = color; markPaintDirty(); return *this; }
+    UISlider& setFont(const sf::Font& f) { font = AssetManager::wrapFont(f); refreshValueText(); markPaintDirty(); return *this; }
+    UISlider& setFont(FontHandle f) { font = std::move(f); refreshValueText(); markPaintDirty(); return *this; }
+    UISlider& setTextSize(unsigned int size) { textSize = size; refreshValueText(); markPaintDirty(); return *this; }
+    UISlider& setTextColor(const sf::Color& color) { textColor = color; markPaintDirty(); return *this; }
     UISlider& setPadding(const sf::Vector2f& pad) { e_padding = pad; markLayoutDirty(); return *this; }
     UISlider& setAnchor(LayoutAnchor anch) { anchor = anch; markLayoutDirty(); return *this; }
     UISlider& setLayoutType(LayoutType type) { layoutType = type; markLayoutDirty(); return *this; }
     UISlider& setSizeType(SizeType type) { sizeType = type; markLayoutDirty(); return *this; }
-    UISlider& setEnable(bool en) { enabled = en; return *this; }
-    UISlider& setVisible(bool vis) { visible = vis; return *this; }
+    UISlider& setEnable(bool en) { SetEnabled(en); return *this; }
+    UISlider& setVisible(bool vis) { SetVisible(vis); return *this; }
 
     // --- Slider-specific setters ---
     UISlider& setRange(float minVal, float maxVal) { minValue = minVal; maxValue = maxVal; setValue(value); return *this; }
-    UISlider& setStep(float s) { step = s; return *this; }
-    UISlider& setValue(float v) { value = std::clamp(v, minValue, maxValue); if (boundValue) *boundValue = value; if (onChange) onChange(value); return *this; }
+    UISlider& setStep(float s) { step = s; markPaintDirty(); return *this; }
+    UISlider& setValue(float v) { value = std::clamp(v, minValue, maxValue); if (boundValue) *boundValue = value; if (onChange) onChange(value); refreshValueText(); markPaintDirty(); return *this; }
     UISlider& setOnChange(std::function<void(float)> cb) { onChange = std::move(cb); return *this; }
-    UISlider& setBoundValue(float* bound) { boundValue = bound; if (bound) setValue(*bound); return *this; }
-    UISlider& setShowValue(bool show) { showValue = show; return *this; }
-    UISlider& setOnTick(std::function<void(UISlider&, const float&)> cb) { onTick = std::move(cb); return *this; }
+    UISlider& setBoundValue(float* bound) { boundValue = bound; if (bound) setValue(*bound); RefreshTick(); return *this; }
+    UISlider& setShowValue(bool show) { showValue = show; refreshValueText(); markPaintDirty(); return *this; }
+    UISlider& setOnTick(std::function<void(UISlider&, const float&)> cb) { onTick = std::move(cb); RefreshTick(); return *this; }
+    // a bound value is only polled, it can't schedule anything by itself
+    bool WantsTick() const override { return onTick || boundValue; }
+    float NextTickIn() const override { return onTick ? 0.f : std::numeric_limits<float>::infinity(); }
+
+    // the handle overhangs the track ends, the value is printed to the right of it
+    sf::FloatRect getDrawBounds() const override {
+        float overhang = e_size.y * 0.2f;
+        sf::FloatRect bounds(e_position.x - overhang, e_position.y, e_size.x + overhang * 2.f, e_size.y);
+        if (showValue) bounds = DamageRegion::Bounding(bounds, valueTextBox());
+        return bounds;
+    }
 
     // --- Drawing ---
-    void DrawSelf(sf::RenderTarget& target, sf::RenderStates states) override {
+    void DrawSelf(RenderBackend& renderer, sf::RenderStates states) override {
         if (!visible) return;
 
-        // Sync with bound value
-        if (boundValue) value =std::clamp(*boundValue, minValue, maxValue);
-
 		// track
         float trackHeight = e_size.y / 6.f;
-        sf::RectangleShape track({e_size.x, trackHeight});
-        track.setPosition(e_position.x, e_position.y + e_size.y / 2.f - trackHeight / 2.f);
-        track.setFillColor(e_fillcolor);
-        track.setOutlineColor(borderColor);
-        track.setOutlineThickness(borderThickness);
-        target.draw(track, states);
+        renderer.FillRect({e_position.x, e_position.y + e_size.y / 2.f - trackHeight / 2.f, e_size.x, trackHeight},
+                          e_fillcolor, borderThickness, borderColor, states);
 
         // Draw handle as rectangle with hover/sliding effect
         float t = (value - minValue) / (maxValue - minValue);
@@ -56,8 +61,6 @@ public:
         float handleHeight = e_size.y * 0.9f;
         float handleX = e_position.x + t * e_size.x - handleWidth / 2.f;
         float handleY = e_position.y + e_size.y / 2.f - handleHeight / 2.f;
-        sf::RectangleShape handle({handleWidth, handleHeight});
-        handle.setPosition(handleX, handleY);
         sf::Color handleColor = (hovered || dragging) ? sf::Color(60, 160, 255) : sf::Color(200, 200, 200);
         if (dragging) {
             // Sliding effect: brighten handle
@@ -65,50 +68,25 @@ public:
             handleColor.g = std::min(255, handleColor.g + 40);
             handleColor.b = std::min(255, handleColor.b + 40);
         }
-        handle.setFillColor(handleColor);
-        handle.setOutlineColor(borderColor);
-        handle.setOutlineThickness(borderThickness);
-        target.draw(handle, states);
+        renderer.FillRect({handleX, handleY, handleWidth, handleHeight}, handleColor, borderThickness, borderColor, states);
 
         // Draw value text
         if (showValue) {
-            sf::Text txt;
-            std::stringstream ss;
-            ss << std::fixed << std::setprecision(2) << value;
-            txt.setString(ss.str());
-
-            txt.setFont(font);
-            txt.setCharacterSize(textSize);
-            txt.setFillColor(textColor);
-            txt.setPosition(e_position.x + e_size.x + 10, e_position.y + e_size.y / 2.f - txt.getLocalBounds().height / 2.f - txt.getLocalBounds().top);
-            target.draw(txt, states);
+            valueText.setFillColor(textColor);
+            sf::FloatRect box = valueTextBox();
+            sf::FloatRect bounds = valueText.measure().bounds;
+            valueText.setPosition(box.left - bounds.left, box.top - bounds.top);
+            renderer.DrawText(valueText, states);
         }
     }
 
-    void CalculateLayout() override {
-        if(layoutType == LayoutType::Static) {
-            e_position = e_offset;
-        } else if(layoutType == LayoutType::Relative) {
-            if (auto parentPtr = parent.lock()) {
-                e_position = parentPtr->e_position + parentPtr->e_padding + e_offset;
-            } else {
-                e_position = e_offset;
-            }
-        } else if(layoutType == LayoutType::Percent) {
-            if (auto parentPtr = parent.lock()) {
-                sf::Vector2f parentSize = parentPtr->e_size - parentPtr->e_padding * 2.0f;
-                e_position.x = parentPtr->e_position.x + parentPtr->e_padding.x + (parentSize.x * (e_offset.x / 100.f));
-                e_position.y = parentPtr->e_position.y + parentPtr->e_padding.y + (parentSize.y * (e_offset.y / 100.f));
-            }
-        } else if(layoutType == LayoutType::Anchor) {
-            e_position = e_offset;
-        }
-    }
 
     void HandleEvent(const UIEvent& event) override {
         if (!enabled) return;
         if (event.type == UIEventType::MouseMove) {
-            hovered = contains(event.mousePos);
+            bool hoveredNow = contains(event.mousePos);
+            if (hoveredNow != hovered) markPaintDirty();
+            hovered = hoveredNow;
             if (dragging) {
                 updateValueFromMouse(event.mousePos.x);
             }
@@ -118,11 +96,21 @@ public:
                 updateValueFromMouse(event.mousePos.x);
             }
         } else if (event.type == UIEventType::MouseUp) {
+            if (dragging) markPaintDirty();
             dragging = false;
         }
     }
 
     void Update(const float dt) override {
+		// the bound value can change from outside, a disabled slider still shows it
+		if (boundValue) {
+			float bound = std::clamp(*boundValue, minValue, maxValue);
+			if (bound != value) {
+				value = bound;
+				refreshValueText();
+				markPaintDirty();
+			}
+		}
 		if(!enabled) return;
 
         if (onTick) onTick(*this, dt);
@@ -133,6 +121,21 @@ private:
         return pt.x >= e_position.x && pt.x <= e_position.x + e_size.x &&
                pt.y >= e_position.y && pt.y <= e_position.y + e_size.y;
     }
+    // formatted once per value change, not per draw. the text's extent is part of the draw bounds,
+    // so the root's store is told whenever it may have changed
+    void refreshValueText() {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.2f", static_cast<double>(value));
+        valueText.setString(buffer);
+        valueText.setFont(font);
+        valueText.setCharacterSize(textSize);
+        if (store) store->SyncBounds(*this);
+    }
+    // where the value's glyphs land: 10px right of the track, centred on it
+    sf::FloatRect valueTextBox() const {
+        sf::FloatRect bounds = valueText.measure().bounds;
+        return {e_position.x + e_size.x + 10 + bounds.left, e_position.y + e_size.y / 2.f - bounds.height / 2.f, bounds.width, bounds.height};
+    }
     void updateValueFromMouse(float mouseX) {
         float t = (mouseX - e_position.x) / e_size.x;
         t = std::clamp(t, 0.f, 1.f);
@@ -147,9 +150,10 @@ private:
     bool hovered = false;
     sf::Color borderColor = sf::Color::Black;
     float borderThickness = 2.f;
-    sf::Font font = AssetManager::get().getFont("fonts/arial.ttf");
+    FontHandle font = AssetManager::get().getFontHandle("fonts/arial.ttf");
     sf::Color textColor = sf::Color::Black;
     unsigned int textSize = 18;
+    TextRun valueText;
     std::function<void(float)> onChange;
     std::function<void(UISlider&, const float&)> onTick;
 };
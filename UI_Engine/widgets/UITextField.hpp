@@ -12,36 +12,39 @@ public:
 
     // --- Standard setters
     UITextField& setOffset(const sf::Vector2f& pos) { e_offset = pos; markLayoutDirty(); return *this; }
-    UITextField& setSize(const sf::Vector2f& size) { e_size = size; markLayoutDirty(); return *this; }
-    UITextField& setFillColor(const sf::Color& color) { e_fillcolor = color; return *this; }
+    UITextField& setSize(const sf::Vector2f& size) { e_requestedSize = size; markLayoutDirty(); return *this; }
+    UITextField& setFillColor(const sf::Color& color) { e_fillcolor = color; markPaintDirty(); return *this; }
     UITextField& setAnchor(LayoutAnchor anch) { anchor = anch; markLayoutDirty(); return *this; }
     UITextField& setLayoutType(LayoutType type) { layoutType = type; markLayoutDirty(); return *this; }
     UITextField& setSizeType(SizeType type) { sizeType = type; markLayoutDirty(); return *this; }
     UITextField& setPadding(const sf::Vector2f& pad) { e_padding = pad; markLayoutDirty(); return *this; }
-    UITextField& setBorder(float thickness, const sf::Color& color) { borderThickness = thickness; borderColor = color; return *this; }
-    UITextField& setFont(const sf::Font& f) { font = f; text.setFont(f); return *this; }
-    UITextField& setStringSize(unsigned int size) { textSize = size; text.setCharacterSize(size); return *this; }
-    UITextField& setStringColor(const sf::Color& color) { textColor = color; text.setFillColor(color); return *this; }
-    UITextField& setString(const std::string& str) { value = str; if(boundValue) *boundValue = str; text.setString(str); return *this; }
+    UITextField& setBorder(float thickness, const sf::Color& color) { borderThickness = thickness; borderColor = color; markPaintDirty(); return *this; }
+    UITextField& setFont(const sf::Font& f) { font = AssetManager::wrapFont(f); text.setFont(font); markContentChanged(); return *this; }
+    UITextField& setFont(FontHandle f) { font = std::move(f); text.setFont(font); markContentChanged(); return *this; }
+    UITextField& setStringSize(unsigned int size) { textSize = size; text.setCharacterSize(size); markContentChanged(); return *this; }
+    UITextField& setStringColor(const sf::Color& color) { textColor = color; text.setFillColor(color); markPaintDirty(); return *this; }
+    UITextField& setString(const std::string& str) { value = str; if(boundValue) *boundValue = str; text.setString(str); markContentChanged(); return *this; }
 	
 	// --- Element specific
     UITextField& setPlaceholder(const std::string& str) {
         placeholder = str;
+        markContentChanged();
         return *this;
     }
 	UITextField& setEnable(bool en) {
-		enabled = en;
+		SetEnabled(en);
 		return *this;
 	}
 	UITextField& setVisible(bool vis) {
-		visible = vis;
+		SetVisible(vis);
 		return *this;
 	}
     UITextField& setPlaceholderColor(const sf::Color& color) {
         placeholderColor = color;
+        markPaintDirty();
         return *this;
     }
-	UITextField& clearText() {value = ""; if(boundValue) *boundValue = ""; text.setString("");
+	UITextField& clearText() {value = ""; if(boundValue) *boundValue = ""; text.setString(""); markContentChanged();
 		return *this;}
 
 	//lambda setters
@@ -55,8 +58,16 @@ public:
     }
     UITextField& setOnTick(std::function<void(UITextField&)> cb) {
         onTick = std::move(cb);
+        RefreshTick();
         return *this;
     }
+	// the caret only blinks while focused, a bound string is polled
+	bool WantsTick() const override { return onTick || focused || boundValue; }
+	float NextTickIn() const override {
+		if (onTick) return 0.f;
+		if (focused) return std::max(0.f, 0.5f - cursorTimer);
+		return std::numeric_limits<float>::infinity();
+	}
 
 	UITextField& setBoundValue(std::string* bound) {
 		boundValue = bound;
@@ -64,11 +75,13 @@ public:
 			value = *bound;
 			text.setString(value);
 		}
+		markPaintDirty();
+		RefreshTick();
 		return *this;
 	}
 
     // --- Drawing ---
-    void DrawSelf(sf::RenderTarget& target, sf::RenderStates states) override {
+    void DrawSelf(RenderBackend& renderer, sf::RenderStates states) override {
 		if(!visible) return;
 
 		if (boundValue && value != *boundValue) {
@@ -82,11 +95,7 @@ public:
 
         // Glow effect: draw a soft blue shadow if focused
         if (focused) {
-            sf::RectangleShape glow(e_size + sf::Vector2f(8, 8));
-            glow.setPosition(e_position - sf::Vector2f(4, 4));
-            glow.setFillColor(sf::Color(60, 160, 255, 40));
-            glow.setOutlineThickness(0);
-            target.draw(glow, states);
+            renderer.FillRect({e_position - sf::Vector2f(4, 4), e_size + sf::Vector2f(8, 8)}, sf::Color(60, 160, 255, 40), 0.f, sf::Color::Transparent, states);
         }
 
         // Slightly brighten background when focused
@@ -97,39 +106,22 @@ public:
             bg.b = std::min(255, bg.b + 30);
         }
 
-        sf::RectangleShape rect(e_size);
-        rect.setPosition(e_position);
-        rect.setFillColor(bg);
-        rect.setOutlineColor(border);
-        rect.setOutlineThickness(thickness);
-        target.draw(rect, states);
+        renderer.FillRect({e_position, e_size}, bg, thickness, border, states);
 
 		if (hasSelection()) {
-			sf::Text selText(text);
-			selText.setString(value.substr(0, selectionStart));
-			float xStart = selText.getLocalBounds().width + e_position.x + 5;
-
-			selText.setString(value.substr(selectionStart, selectionEnd - selectionStart));
-			float width = selText.getLocalBounds().width;
+			float xStart = AdvanceOf(selectionStart) + e_position.x + 5;
+			float width = AdvanceOf(selectionEnd) - AdvanceOf(selectionStart);
 
-			sf::RectangleShape highlight({width, float(textSize)});
-			highlight.setPosition({xStart, e_position.y + 5});
-			highlight.setFillColor(sf::Color(100, 100, 255, 70)); // semi-transparent blue
-			target.draw(highlight, states);
+			renderer.FillRect({xStart, e_position.y + 5, width, float(textSize)}, sf::Color(100, 100, 255, 70), 0.f, sf::Color::Transparent, states); // semi-transparent blue
 		}
 
         // text placeholder
         std::string display = boundValue ? *boundValue : value;
 
-        sf::Text caretText(text);
-		caretText.setString(value.substr(0, cursorIndex));
-		float caretX = caretText.getLocalBounds().width;
+		float caretX = AdvanceOf(cursorIndex);
 
 		if (focused && showCursor) {
-			sf::RectangleShape cursor(sf::Vector2f(1, textSize));
-			cursor.setPosition({e_position.x + 7 + caretX, e_position.y + textSize/2});
-			cursor.setFillColor(sf::Color::Black);
-			target.draw(cursor, states);
+			renderer.FillRect({e_position.x + 7 + caretX, e_position.y + textSize/2, 1.f, float(textSize)}, sf::Color::Black, 0.f, sf::Color::Transparent, states);
 		}
 
         text.setFont(font);
@@ -138,27 +130,20 @@ public:
         text.setString(display);
         text.setPosition(e_position.x + 5, e_position.y + (e_size.y - text.getLocalBounds().height) / 2.f - text.getLocalBounds().top);
         if (!value.empty() || (focused && showCursor)) {
-            target.draw(text, states);
+            renderer.DrawText(text, states);
         } else if (!placeholder.empty()) {
-            sf::Text ph;
-            ph.setFont(font);
-            ph.setCharacterSize(textSize);
-            ph.setString(placeholder);
+            placeholderText.setFont(font);
+            placeholderText.setCharacterSize(textSize);
+            placeholderText.setString(placeholder);
             sf::Color phColor = placeholderColor;
             phColor.a = 120; // semi-transparent
-            ph.setFillColor(phColor);
-            ph.setPosition(e_position.x + 5, e_position.y + (e_size.y - ph.getLocalBounds().height) / 2.f - ph.getLocalBounds().top);
-            target.draw(ph, states);
+            placeholderText.setFillColor(phColor);
+            placeholderText.setPosition(e_position.x + 5, e_position.y + (e_size.y - placeholderText.getLocalBounds().height) / 2.f - placeholderText.getLocalBounds().top);
+            renderer.DrawText(placeholderText, states);
         }
 
 		if (layoutDirty) {
-			sf::ConvexShape triangle;
-			triangle.setPointCount(3);
-			triangle.setPoint(0, e_position);
-			triangle.setPoint(1, e_position + sf::Vector2f(10, 0));
-			triangle.setPoint(2, e_position + sf::Vector2f(0, 10));
-			triangle.setFillColor(sf::Color::Red);
-			target.draw(triangle, states);
+			renderer.FillTriangle(e_position, e_position + sf::Vector2f(10, 0), e_position + sf::Vector2f(0, 10), sf::Color::Red, states);
 		}
     }
 
@@ -172,67 +157,44 @@ public:
 			if (cursorTimer > 0.5f) {
 				showCursor = !showCursor;
 				cursorTimer = 0.f;
+				markPaintDirty();
 			}
 		} else {
 			showCursor = false;
 		}
+		if (boundValue && value != *boundValue) {
+			value = *boundValue;
+			text.setString(value);
+			markPaintDirty();
+		}
 
 	}
 
-    void CalculateLayout() override {
-		if(!layoutDirty) return;
-		layoutDirty = false;
-
-        if(layoutType == LayoutType::Static) {
-            e_position = e_offset;
-        } else if(layoutType == LayoutType::Relative) {
-            if (auto parentPtr = parent.lock()) {
-                e_position = parentPtr->e_position + parentPtr->e_padding + e_offset;
-            } else {
-                e_position = e_offset;
-            }
-        } else if(layoutType == LayoutType::Percent) {
-            if (auto parentPtr = parent.lock()) {
-                sf::Vector2f parentSize = parentPtr->e_size - parentPtr->e_padding * 2.0f;
-                e_position.x = parentPtr->e_position.x + parentPtr->e_padding.x + (parentSize.x * (e_offset.x / 100.f));
-                e_position.y = parentPtr->e_position.y + parentPtr->e_padding.y + (parentSize.y * (e_offset.y / 100.f));
-            }
-        } else if(layoutType == LayoutType::Anchor) {
-            e_position = e_offset;
-        }
-
-		// Calculate size based on sizeType
-		if (sizeType == SizeType::FitContent) {
-			sf::Text tempText(value.empty() ? placeholder : value, font, textSize);
-			sf::FloatRect bounds = tempText.getLocalBounds();
-			float width = bounds.width + e_padding.x * 2.f + 20.f; // +10 to account for cursor or buffer
-			float height = bounds.height + e_padding.y * 2.f + 20.f;
-
-			e_size = { width, height };
-		} else if (sizeType == SizeType::FillParent) {
-			// Fill parent logic (e.g., match parent's size)
-			if (auto parentPtr = parent.lock()) {
-				e_size = parentPtr->e_size-parentPtr->e_padding/0.5f - e_offset;
-			}
-		} else if (sizeType == SizeType::Percent) {
-			// Percent size logic (e.g., based on parent's size)
-			if (auto parentPtr = parent.lock()) {
-				auto parentArea = parentPtr->e_size - parentPtr->e_padding/0.5f;
-				e_size.x = parentArea.x * (e_size.x / 100.f);
-				e_size.y = parentArea.y * (e_size.y / 100.f);
-			}
-		}
+protected:
+    sf::Vector2f MeasureContent(const sf::Vector2f& available) override {
+		sf::FloatRect bounds;
+		if (font) bounds = TextMeasureCache::get().Measure(*font, textSize, value.empty() ? placeholder : value).bounds;
+		float width = bounds.width + e_padding.x * 2.f + 20.f; // +10 to account for cursor or buffer
+		float height = bounds.height + e_padding.y * 2.f + 20.f;
+		return { width, height };
     }
 
+public:
+	bool IsFocusable() const override { return true; }
+	void OnFocusChanged(bool hasFocus) override {
+		focused = hasFocus;
+		cursorTimer = 0.f;
+		if (!focused) showCursor = false;
+		markPaintDirty();
+		RefreshTick();
+	}
+
     void HandleEvent(const UIEvent& event) override {
         if (!enabled) return; // Ignore events if not enabled
 
         bool changed = false;
-        if (event.type == UIEventType::MouseDown) {
-            focused = contains(event.mousePos);
-        }
-
 		if(!focused) return;
+		markPaintDirty();	// text, caret or selection may move
 
         if (event.type == UIEventType::TextEntered && event.textChar >= 32 && event.textChar < 127) {
 			pushUndoState();
@@ -265,7 +227,9 @@ public:
 					cursorIndex++;
 					changed = true;
 				}else{
-					focused = false;
+					// the manager would keep routing keys here otherwise, OnFocusChanged clears the flag
+					if (context && context->focus.GetFocused() == this) context->focus.SetFocus(nullptr);
+					else OnFocusChanged(false);
 					if (onEnter){
 						onEnter(value);
 					}
@@ -340,9 +304,19 @@ private:
         return pt.x >= e_position.x && pt.x <= e_position.x + e_size.x &&
                pt.y >= e_position.y && pt.y <= e_position.y + e_size.y;
     }
+	// FitContent fields are sized by their text, the rest only repaint
+	void markContentChanged() {
+		if (sizeType == SizeType::FitContent) markLayoutDirty();
+		else markPaintDirty();
+	}
 	bool hasSelection()  {
 		return selectionEnd > selectionStart;
 	}
+	// pen advance after value's first count bytes, what the caret and the selection line up with
+	float AdvanceOf(std::size_t count) const {
+		if (!font) return 0.f;
+		return TextMeasureCache::get().Measure(*font, textSize, std::string_view(value).substr(0, count)).advance;
+	}
 	void pushUndoState() {
 		if (undoStack.empty() || undoStack.back() != value) {
 			undoStack.push_back(value);
@@ -350,8 +324,9 @@ private:
 		}
 	}
     std::string value;
-    sf::Text text;
-    sf::Font font = AssetManager::get().getFont("fonts/arial.ttf");
+    TextRun text;
+    TextRun placeholderText;
+    FontHandle font = AssetManager::get().getFontHandle("fonts/arial.ttf");
     sf::Color textColor = sf::Color::Black;
     unsigned int textSize = 18;
     bool focused = false;
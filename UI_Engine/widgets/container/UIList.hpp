@@ -2,11 +2,25 @@
 
 #include "core/UIElement.hpp"
 #include <SFML/Graphics/RectangleShape.hpp>
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
 
+/*
+	stacks its children top to bottom. with setDataSource the list is virtualized instead: it holds
+	no child per item, only a pool of rows big enough to cover the visible area (plus overscan),
+	which are rebound to whatever items scroll into view. row tops come from a fixed height or
+	from a prefix sum of cached per-item heights, so scrolling costs the same for 100 items or 100k.
+	a virtualized list keeps its rows in its own ElementStore, clipped to the content area.
+*/
 class UIList : public UIContainer {
 public:
-    UIList(const std::string& name = defaultName()) : UIContainer(name) {}
+    UIList(const std::string& name = defaultName()) : UIContainer(name) { rowStore.SetOwner(this); }
+	~UIList() {
+		// the row store goes away before the children vector does
+		if (virtualized) for (auto& child : children) child->AttachTo(nullptr, nullptr);
+	}
 
     // Builder setters
     UIList& setOffset(const sf::Vector2f& pos) {
@@ -15,16 +29,18 @@ public:
         return *this;
     }
     UIList& setSize(const sf::Vector2f& size) {
-        e_size = size;
+        e_requestedSize = size;
 		markLayoutDirty();
         return *this;
     }
     UIList& setFillColor(const sf::Color& color) {
         e_fillcolor = color;
+        markPaintDirty();
         return *this;
     }
     UIList& setAnchor(LayoutAnchor anch) {
         anchor = anch;
+        markPaintDirty();
         return *this;
     }
     UIList& setLayoutType(LayoutType type) {
@@ -44,10 +60,12 @@ public:
 	}
 	UIList& setHeaderTitle(const std::string& title) {
         headerTitle = title;
+        markPaintDirty();
         return *this;
     }
     UIList& setHeaderColor(const sf::Color& color) {
         headerColor = color;
+        markPaintDirty();
         return *this;
     }
     UIList& setHeaderHeight(float height) {
@@ -57,41 +75,195 @@ public:
     }
 
 	UIList& setEnable(bool en) {
-		enabled = en;
+		SetEnabled(en);
 		return *this;
 	}
 
 	UIList& setVisible(bool vis) {
-		visible = vis;
+		SetVisible(vis);
 		return *this;
 	}
 
 	UIList& setSpacing(float space) {
 		spacing = space;
 		markLayoutDirty();
+		reloadData();
 		return *this;
 	}
 
-	UIList& setOnTick(std::function<void(UIList&, const float)> cb) { onTick = std::move(cb); return *this; }
+	UIList& setOnTick(std::function<void(UIList&, const float)> cb) { onTick = std::move(cb); RefreshTick(); return *this; }
+	bool WantsTick() const override { return static_cast<bool>(onTick); }
 
-	void Update(const float dt) override {
-		if(!enabled) return;
-		for (auto& child : children) {
-			child->Update(dt);
+	// switches the list to virtualized rows: itemCount is asked on reloadData, createRow makes a pooled
+	// row widget, bindRow fills a row in for an item whenever it comes into view. children added before are dropped
+	UIList& setDataSource(std::function<std::size_t()> itemCount, std::function<std::shared_ptr<UIElement>()> createRow,
+						  std::function<void(UIElement& row, std::size_t item)> bindRow) {
+		while (!children.empty()) RemoveChild(children.back().get());
+		rowItems.clear();
+		countSource = std::move(itemCount);
+		rowFactory = std::move(createRow);
+		rowBinder = std::move(bindRow);
+		virtualized = true;
+		// our slot in the root's store turns into a boundary
+		if (store) store->MarkDirty();
+		reloadData();
+		return *this;
+	}
+	// every row is this tall (virtualized lists)
+	UIList& setRowHeight(float height) {
+		rowHeight = height;
+		heightSource = nullptr;
+		reloadData();
+		return *this;
+	}
+	// rows differ in height, heightOf is asked once per item on reloadData and cached
+	UIList& setRowHeight(std::function<float(std::size_t item)> heightOf) {
+		heightSource = std::move(heightOf);
+		reloadData();
+		return *this;
+	}
+	// extra rows bound above and below the visible ones, so a short scroll doesn't rebind
+	UIList& setOverscan(std::size_t rows) {
+		overscan = rows;
+		SyncRows();
+		return *this;
+	}
+	UIList& setScrollOffset(float offset) {
+		offset = std::clamp(offset, 0.f, MaxScroll());
+		if (offset == scrollOffset) return *this;
+		scrollOffset = offset;
+		// only the translation and the rows at the edges change, no layout pass
+		SyncRows();
+		markPaintDirty();
+		return *this;
+	}
+	float getScrollOffset() const { return scrollOffset; }
+	// scrolls just far enough to show the whole item
+	UIList& scrollToItem(std::size_t item) {
+		if (item >= itemCount) return *this;
+		float top = ItemTop(item), bottom = top + ItemHeight(item);
+		if (top < scrollOffset) return setScrollOffset(top);
+		if (bottom > scrollOffset + ViewportHeight()) return setScrollOffset(bottom - ViewportHeight());
+		return *this;
+	}
+
+	// the item count or the heights changed: re-reads both and rebinds the visible rows. O(items) with
+	// variable heights, for one changed item rebindItem is enough
+	void reloadData() {
+		if (!virtualized) return;
+		itemCount = countSource ? countSource() : 0;
+		itemTops.clear();
+		if (heightSource) {
+			itemTops.reserve(itemCount + 1);
+			float top = 0.f;
+			for (std::size_t i = 0; i < itemCount; i++) {
+				itemTops.push_back(top);
+				top += heightSource(i) + spacing;
+			}
+			itemTops.push_back(top);
+		}
+		UnbindRows();
+		scrollOffset = std::clamp(scrollOffset, 0.f, MaxScroll());
+		SyncRows();
+		markPaintDirty();
+	}
+	// binds the item's row again if it is showing
+	void rebindItem(std::size_t item) {
+		for (std::size_t slot = 0; slot < rowItems.size(); slot++) {
+			if (rowItems[slot] == item && rowBinder) rowBinder(*children[slot], item);
+		}
+	}
+
+	bool isVirtualized() const { return virtualized; }
+	std::size_t getItemCount() const { return itemCount; }
+	// row widgets that exist, independent of the item count
+	std::size_t getRowCount() const { return children.size(); }
+	// bound row showing item, nullptr if it's scrolled out of view
+	UIElement* getRowForItem(std::size_t item) const {
+		if (children.empty()) return nullptr;
+		std::size_t slot = item % children.size();
+		return rowItems[slot] == item ? children[slot].get() : nullptr;
+	}
+
+	// rows are laid out below the padding and shifted up by the scroll offset
+	sf::Vector2f ChildTranslation() const override {
+		return virtualized ? e_position + sf::Vector2f(e_padding.x, e_padding.y - scrollOffset) : sf::Vector2f(0, 0);
+	}
+	ElementStore* ChildStore() override { return virtualized ? &rowStore : store; }
+	bool WantsWheel() const override { return virtualized; }
+	// pooled rows jump between items as the list scrolls, that's no move to animate
+	bool AnimatesChildren() const override { return !virtualized && UIContainer::AnimatesChildren(); }
+
+	// the header bar is drawn above e_position
+	sf::FloatRect getDrawBounds() const override {
+		return {e_position.x, e_position.y - headerHeight, e_size.x, e_size.y + headerHeight};
+	}
+
+	UIElement* HitTest(const sf::Vector2f& point) override {
+		if (!virtualized) return UIContainer::HitTest(point);
+		if (!enabled || !visible || !getHitBounds().contains(point)) return nullptr;
+		if (Viewport().contains(point)) {
+			sf::Vector2f local = point - ChildTranslation();
+			std::int32_t slot = rowStore.TopmostAt(local);
+			if (slot >= 0) {
+				if (UIElement* inner = rowStore.elements[slot]->HitTest(local - rowStore.VisualOffset(slot))) return inner;
+			}
+		}
+		return this;
+	}
+
+	void HandleSelfEvent(const UIEvent& event) override {
+		if (!enabled) return;
+		if (event.type == UIEventType::MouseWheel && virtualized) {
+			setScrollOffset(scrollOffset - event.wheelDelta * WheelStep);
+		}
+	}
+
+	// virtualized rows are drawn off the row store, clipped to the content area
+	void Render(RenderBackend& renderer, sf::RenderStates states = sf::RenderStates::Default) override {
+		if (!virtualized) {
+			UIContainer::Render(renderer, states);
+			return;
+		}
+		if (!enabled) return;
+		if (!OutsideClip(renderer, states, getDrawBounds())) {
+			DrawVisits++;
+			DrawSelf(renderer, states);
 		}
+
+		rowStore.Ensure();
+		renderer.PushClip(Viewport(), states);
+		states.transform.translate(ChildTranslation());
+		bool offsets = rowStore.HasOffsets();
+		for (std::size_t i = 0; i < rowStore.Size(); ) {
+			std::uint8_t f = rowStore.flags[i];
+			if (ElementStore::SkipsRender(f)) {
+				i = rowStore.subtreeEnds[i];
+				continue;
+			}
+			UIElement* element = rowStore.elements[i];
+			sf::RenderStates elementStates = states;
+			if (offsets) elementStates.transform.translate(rowStore.VisualOffset(static_cast<std::int32_t>(i)));
+			if (f & ElementStore::Boundary) {
+				element->Render(renderer, elementStates);
+			} else if (!OutsideClip(renderer, elementStates, rowStore.drawBounds[i])) {
+				DrawVisits++;
+				element->DrawSelf(renderer, elementStates);
+			}
+			i++;
+		}
+		renderer.PopClip();
+	}
+
+	void UpdateSelf(const float dt) override {
 		if(onTick) onTick(*this, dt);
 	}
 
-    void DrawSelf(sf::RenderTarget& target, sf::RenderStates states) override {
+    void DrawSelf(RenderBackend& renderer, sf::RenderStates states) override {
 		if(!visible) return;
 
         // main background
-        sf::RectangleShape rect(e_size);
-        rect.setPosition(e_position);
-        rect.setFillColor(e_fillcolor);
-        rect.setOutlineColor(sf::Color::Black);
-        rect.setOutlineThickness(2.f);
-        target.draw(rect, states);
+        renderer.FillRect({e_position, e_size}, e_fillcolor, 2.f, sf::Color::Black, states);
 
         // header bar
         if (headerHeight > 0.f) {
@@ -99,118 +271,180 @@ public:
             headerBarColor.r = static_cast<sf::Uint8>(headerBarColor.r * 0.7f);
             headerBarColor.g = static_cast<sf::Uint8>(headerBarColor.g * 0.7f);
             headerBarColor.b = static_cast<sf::Uint8>(headerBarColor.b * 0.7f);
-            sf::RectangleShape headerRect({e_size.x, headerHeight});
-            headerRect.setPosition(e_position.x, e_position.y - headerHeight);
-            headerRect.setFillColor(headerBarColor);
-            headerRect.setOutlineColor(sf::Color::Black);
-            headerRect.setOutlineThickness(2.f);
-            target.draw(headerRect, states);
-
-            sf::Text headerText;
+            renderer.FillRect({e_position.x, e_position.y - headerHeight, e_size.x, headerHeight}, headerBarColor, 2.f, sf::Color::Black, states);
+
             headerText.setString(headerTitle);
             headerText.setCharacterSize(24);
             headerText.setFillColor(sf::Color::White);
             headerText.setFont(font);
             headerText.setPosition(e_position.x + 10, (e_position.y - headerHeight) + (headerHeight - headerText.getLocalBounds().height) / 2.f - headerText.getLocalBounds().top);
-            target.draw(headerText, states);
+            renderer.DrawText(headerText, states);
         }
 
 		if (layoutDirty) {
-			sf::ConvexShape triangle;
-			triangle.setPointCount(3);
-			triangle.setPoint(0, e_position);
-			triangle.setPoint(1, e_position + sf::Vector2f(10, 0));
-			triangle.setPoint(2, e_position + sf::Vector2f(0, 10));
-			triangle.setFillColor(sf::Color::Red);
-			target.draw(triangle, states);
+			renderer.FillTriangle(e_position, e_position + sf::Vector2f(10, 0), e_position + sf::Vector2f(0, 10), sf::Color::Red, states);
 		}
     }
 
-    void CalculateLayout() override {
-		if(!layoutDirty) return;
-		layoutDirty = false;
-
-        if(layoutType == LayoutType::Static) {
-            e_position = e_offset;
-        } else if(layoutType == LayoutType::Relative) {
-            if (auto parentPtr = parent.lock()) {
-                e_position = parentPtr->e_position + parentPtr->e_padding + e_offset;
-            } else {
-                e_position = e_offset;
-            }
-        } else if(layoutType == LayoutType::Percent) {
-            if (auto parentPtr = parent.lock()) {
-                sf::Vector2f parentSize = parentPtr->e_size - parentPtr->e_padding * 2.0f;
-                e_position.x = parentPtr->e_position.x + parentPtr->e_padding.x + (parentSize.x * (e_offset.x / 100.f));
-                e_position.y = parentPtr->e_position.y + parentPtr->e_padding.y + (parentSize.y * (e_offset.y / 100.f));
-            }
-        } else if(layoutType == LayoutType::Anchor) {
-            e_position = e_offset;
-        }
+protected:
+	// children are stacked top to bottom, their offset only moves them horizontally.
+	// a virtualized list doesn't grow with its items, it keeps the requested size
+    sf::Vector2f MeasureContent(const sf::Vector2f& available) override {
+		if (virtualized) return e_requestedSize;
+		sf::Vector2f area = e_size - e_padding * 2.f;
+		sf::Vector2f maxSize(0, 0);
+		float currentY = e_padding.y;
+		for (auto& child : children) {
+			child->Measure(area);
+			maxSize.x = std::max(maxSize.x, e_padding.x + child->ResolvePosition({0, 0}, area).x + child->e_size.x);
+			maxSize.y = std::max(maxSize.y, currentY + child->e_size.y);
+			currentY += child->e_size.y + spacing;
+		}
+		return maxSize + e_padding * 2.f;
+    }
 
-		interpolated_position = e_position;
+	void ArrangeChildren() override {
+		if (virtualized) {
+			// the viewport may have changed size
+			scrollOffset = std::clamp(scrollOffset, 0.f, MaxScroll());
+			SyncRows(true);
+			return;
+		}
+		sf::Vector2f origin = e_position + e_padding;
+		sf::Vector2f area = e_size - e_padding * 2.f;
+		float currentY = origin.y;
+		for (auto& child : children) {
+			child->Measure(area);
+			child->PlaceAt({child->ResolvePosition(origin, area).x, currentY});
+			currentY += child->e_size.y + spacing;
+		}
+	}
 
-		float currentY;
-        if (sizeType == SizeType::FitContent) {
-			currentY = e_position.y + e_padding.y;
-			for (auto& child : children) {
-				child->CalculateLayout();
-				child->e_position.y = currentY;
-				currentY += child->e_size.y + spacing; // Stack children vertically with spacing
-			}
+public:
 
-            sf::Vector2f maxSize(0, 0);
-            for (const auto& child : children) {
-                sf::Vector2f childBR = child->e_position + child->e_size - e_position; // bottom-right relative to root
-                maxSize.x = std::max(maxSize.x, childBR.x);
-                maxSize.y = std::max(maxSize.y, childBR.y);
-            }
-            e_size = maxSize + e_padding * 2.f;
-        } else if (sizeType == SizeType::FillParent) {
-            if (auto parentPtr = parent.lock()) {
-                e_size = parentPtr->e_size-parentPtr->e_padding*2.f - e_offset;
-            }
-        } else if (sizeType == SizeType::Percent) {
-            if (auto parentPtr = parent.lock()) {
-                auto parentArea = parentPtr->e_size - parentPtr->e_padding*2.f;
-                e_size.x = parentArea.x * (e_size.x / 100.f);
-                e_size.y = parentArea.y * (e_size.y / 100.f);
-            }
-        }
+private:
+	static constexpr std::size_t NoItem = std::numeric_limits<std::size_t>::max();
+	static constexpr float WheelStep = 40.f;	// pixels per wheel notch
 
-		currentY = e_position.y + e_padding.y;
-        for (auto& child : children) {
-            child->CalculateLayout();
+	float ViewportHeight() const { return std::max(0.f, e_size.y - e_padding.y * 2.f); }
+	// content area in the parent's space, what rows are clipped to
+	sf::FloatRect Viewport() const {
+		return {e_position + e_padding, {std::max(0.f, e_size.x - e_padding.x * 2.f), ViewportHeight()}};
+	}
+	float ItemTop(std::size_t item) const {
+		return heightSource ? itemTops[item] : static_cast<float>(item) * (rowHeight + spacing);
+	}
+	float ItemHeight(std::size_t item) const {
+		return heightSource ? itemTops[item + 1] - itemTops[item] - spacing : rowHeight;
+	}
+	float ContentHeight() const {
+		return itemCount == 0 ? 0.f : ItemTop(itemCount) - spacing;
+	}
+	float MaxScroll() const { return std::max(0.f, ContentHeight() - ViewportHeight()); }
+	// item whose row covers y (content space), clamped to the items there are
+	std::size_t ItemAt(float y) const {
+		if (itemCount == 0 || y <= 0.f) return 0;
+		std::size_t item;
+		if (heightSource) {
+			item = static_cast<std::size_t>(std::upper_bound(itemTops.begin(), itemTops.begin() + itemCount, y) - itemTops.begin()) - 1;
+		} else {
+			item = static_cast<std::size_t>(y / (rowHeight + spacing));
+		}
+		return std::min(item, itemCount - 1);
+	}
 
-			child->e_position.y = currentY;
-			currentY += child->e_size.y + spacing;
-        }
-    }
+	// binds rows to the items from the top of the viewport to its bottom (plus overscan) and places them.
+	// item i always goes to pool slot i % pool size, so rows that stay in view keep their binding, and
+	// their place too (rows sit in content space): a scroll only touches the rows it rebinds
+	void SyncRows(bool placeAll = false) {
+		if (!virtualized || !rowFactory) return;
 
-    UIElement* AddChild(std::shared_ptr<UIElement> child) override {
-        children.push_back(child);
-        child->parent = shared_from_this();
-		markLayoutDirty();
-        return child.get();
-    }
+		std::size_t first = 0, last = 0;
+		if (itemCount > 0) {
+			first = ItemAt(scrollOffset);
+			last = ItemAt(scrollOffset + ViewportHeight()) + 1;
+			first = first > overscan ? first - overscan : 0;
+			last = std::min(itemCount, last + overscan);
+		}
 
-    void HandleEvent(const UIEvent& event) override {
-		if (!enabled) return;
+		if (last - first > children.size()) {
+			while (children.size() < last - first) AddRow();
+			// the pool size changed, so did every item's slot
+			UnbindRows();
+		}
 
-        for (auto& child : children) {
-            child->HandleEvent(event);
-        }
-    }
+		const std::size_t pool = children.size();
+		for (std::size_t slot = 0; slot < pool; slot++) {
+			if (rowItems[slot] == NoItem || (rowItems[slot] >= first && rowItems[slot] < last)) continue;
+			rowItems[slot] = NoItem;
+			ShowRow(*children[slot], false);
+		}
+
+		sf::Vector2f area(std::max(0.f, e_size.x - e_padding.x * 2.f), ViewportHeight());
+		for (std::size_t item = first; item < last; item++) {
+			std::size_t slot = item % pool;
+			UIElement& row = *children[slot];
+			if (rowItems[slot] != item) {
+				if (rowItems[slot] == NoItem) ShowRow(row, true);
+				rowItems[slot] = item;
+				if (rowBinder) rowBinder(row, item);
+			} else if (!placeAll && !row.NeedsLayout()) {
+				continue;
+			}
+			row.Measure(area);
+			row.PlaceAt({row.ResolvePosition({0, 0}, area).x, ItemTop(item)});
+		}
+	}
+
+	// hides every bound row, SyncRows shows and rebinds the ones still in range
+	void UnbindRows() {
+		for (std::size_t slot = 0; slot < rowItems.size(); slot++) {
+			if (rowItems[slot] == NoItem) continue;
+			rowItems[slot] = NoItem;
+			ShowRow(*children[slot], false);
+		}
+	}
+
+	// pool rows go straight into the row store, without dirtying our own layout
+	void AddRow() {
+		std::shared_ptr<UIElement> row = rowFactory();
+		children.push_back(row);
+		row->parent = shared_from_this();
+		row->AttachTo(&rowStore, context);
+		rowStore.MarkDirty();
+		rowItems.push_back(NoItem);
+		ShowRow(*row, false);
+		TreeVersion++;
+	}
+
+	static void ShowRow(UIElement& row, bool show) {
+		row.SetEnabled(show);
+		row.SetVisible(show);
+	}
 
-private:
     std::string headerTitle = "";
     sf::Color headerColor = sf::Color(60, 60, 60);
     float headerHeight = 30.f;
-    sf::Font font = AssetManager::get().getFont("fonts/arial.ttf");
+    TextRun headerText;
+    FontHandle font = AssetManager::get().getFontHandle("fonts/arial.ttf");
 
     // --- Dragging state ---
     bool dragging = false;
     sf::Vector2f dragOffset; // Mouse offset from top-left of root when drag starts
 
     std::function<void(UIList&, const float dt)> onTick;
+
+	// --- Virtualized rows (setDataSource) ---
+	bool virtualized = false;
+	ElementStore rowStore;	// the pooled rows, in content space (see ChildTranslation)
+	std::function<std::size_t()> countSource;
+	std::function<std::shared_ptr<UIElement>()> rowFactory;
+	std::function<void(UIElement&, std::size_t)> rowBinder;
+	std::function<float(std::size_t)> heightSource;	// unset = every row is rowHeight
+	std::size_t itemCount = 0;
+	std::vector<float> itemTops;	// prefix sums of the item heights plus spacing, itemCount + 1 entries
+	std::vector<std::size_t> rowItems;	// item bound to each pool row, NoItem if it's hidden
+	float rowHeight = 30.f;
+	float scrollOffset = 0.f;
+	std::size_t overscan = 2;
 };
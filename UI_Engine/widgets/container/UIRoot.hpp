@@ -1,31 +1,43 @@
 #pragma once
 
 #include "core/UIElement.hpp"
+#include "core/DamageRegion.hpp"
 #include <SFML/Graphics/RectangleShape.hpp>
+#include <cmath>
 #include <functional>
 
 class UIRoot : public UIContainer {
 public:
-    UIRoot(const std::string& name = defaultName()) : UIContainer(name) {}
+    UIRoot(const std::string& name = defaultName()) : UIContainer(name) { childStore.SetOwner(this); }
+	~UIRoot() {
+		// the store goes away before the children vector does
+		for (auto& child : children) child->AttachTo(nullptr, nullptr);
+	}
 
     // Builder setters
     UIRoot& setOffset(const sf::Vector2f& pos) {
         e_offset = pos;
-		interpolated_position = pos;
-		markLayoutDirty();
+		// children are laid out relative to the root, so moving a top-level root is only a new translation
+		if (parent.expired() && layoutType != LayoutType::Percent) {
+			MoveTo(pos);
+		} else {
+			markLayoutDirty();
+		}
         return *this;
     }
     UIRoot& setSize(const sf::Vector2f& size) {
-        e_size = size;
+        e_requestedSize = size;
 		markLayoutDirty();
         return *this;
     }
     UIRoot& setFillColor(const sf::Color& color) {
         e_fillcolor = color;
+        markPaintDirty();
         return *this;
     }
     UIRoot& setAnchor(LayoutAnchor anch) {
         anchor = anch;
+        markPaintDirty();
         return *this;
     }
     UIRoot& setLayoutType(LayoutType type) {
@@ -45,10 +57,12 @@ public:
 	}
 	UIRoot& setHeaderTitle(const std::string& title) {
         headerTitle = title;
+        markPaintDirty();
         return *this;
     }
     UIRoot& setHeaderColor(const sf::Color& color) {
         headerColor = color;
+        markPaintDirty();
         return *this;
     }
     UIRoot& setHeaderHeight(float height) {
@@ -57,35 +71,139 @@ public:
         return *this;
     }
 	UIRoot& setEnable(bool en) {
-		enabled = en;
+		SetEnabled(en);
 		return *this;
 	}
 	UIRoot& setVisible(bool vis) {
-		visible = vis;
+		SetVisible(vis);
+		return *this;
+	}
+	// draw the whole root into an offscreen layer and composite that as one quad. the layer is redrawn
+	// only when something inside changes, moving the root reuses it. for panels that rarely change
+	UIRoot& setCached(bool cache) {
+		cached = cache;
+		layerValid = false;
+		markPaintDirty();
 		return *this;
 	}
 	UIRoot& setOnTick(std::function<void(UIRoot&)> cb) {
-		 onTick = std::move(cb); return *this; }
+		 onTick = std::move(cb); RefreshTick(); return *this; }
+	bool WantsTick() const override { return static_cast<bool>(onTick); }
+
+	void UpdateSelf(const float dt) override {
+		if(onTick) onTick(*this);
+	}
 
-	void Update(const float dt) override {
+	void Render(RenderBackend& renderer, sf::RenderStates states = sf::RenderStates::Default) override {
 		if(!enabled) return;
-		for (auto& child : children) {
-			child->Update(dt);
+		childStore.Ensure();
+		if (!cached) {
+			RenderContent(renderer, states);
+			return;
+		}
+
+		// the layer's extent is kept relative to the root, so a drag is still a hit
+		bool hit = layerValid && renderer.HasLayer(this);
+		if (!hit) {
+			sf::FloatRect bounds = LocalPaintBounds();
+			sf::Vector2f corner(std::floor(bounds.left), std::floor(bounds.top));
+			layerSize = sf::Vector2u(static_cast<unsigned>(std::ceil(bounds.left + bounds.width - corner.x)),
+									 static_cast<unsigned>(std::ceil(bounds.top + bounds.height - corner.y)));
+			layerOffset = corner - e_position;
+		}
+		sf::FloatRect layerRect(e_position + layerOffset, sf::Vector2f(layerSize));
+		if (OutsideClip(renderer, states, layerRect)) return;
+
+		if (hit) {
+			LayerHits++;
+		} else {
+			// valid before drawing, so anything marked while we draw invalidates it again
+			layerValid = true;
+			if (!renderer.BeginLayer(this, layerSize)) {
+				layerValid = false;
+				RenderContent(renderer, states);
+				return;
+			}
+			LayerMisses++;
+			sf::RenderStates layerStates;
+			layerStates.transform.translate(-layerRect.left, -layerRect.top);
+			RenderContent(renderer, layerStates);
+			renderer.EndLayer();
+		}
+		renderer.DrawLayer(this, layerRect, states);
+	}
+
+	void InvalidateLayer() override { layerValid = false; }
+
+	// layer reuse since start, GUI turns these into per-frame counts
+	inline static int LayerHits = 0;
+	inline static int LayerMisses = 0;
+
+	// the children move with the root, so a drag damages wherever any of them is
+	sf::FloatRect getPaintBounds() const override {
+		sf::FloatRect bounds = LocalPaintBounds();
+		sf::Vector2f global = getGlobalPosition();
+		bounds.left += global.x - e_position.x;
+		bounds.top += global.y - e_position.y;
+		return bounds;
+	}
+private:
+	// self and children, in the same space as e_position (paint margin included)
+	sf::FloatRect LocalPaintBounds() const {
+		sf::FloatRect own = getDrawBounds();
+		sf::FloatRect bounds(own.left - PaintMargin, own.top - PaintMargin, own.width + PaintMargin * 2.f, own.height + PaintMargin * 2.f);
+		if (childStore.IsDirty()) return bounds;	// structure changed, the added/removed elements report themselves
+
+		sf::Vector2f origin = ChildTranslation();
+		bool offsets = childStore.HasOffsets();
+		for (std::size_t i = 0; i < childStore.Size(); i++) {
+			if (ElementStore::SkipsRender(childStore.flags[i])) continue;
+			sf::FloatRect child = childStore.drawBounds[i];
+			sf::Vector2f shift = origin;
+			if (offsets) shift += childStore.VisualOffset(static_cast<std::int32_t>(i));
+			child.left += shift.x;
+			child.top += shift.y;
+			bounds = DamageRegion::Bounding(bounds, {child.left - PaintMargin, child.top - PaintMargin, child.width + PaintMargin * 2.f, child.height + PaintMargin * 2.f});
+		}
+		return bounds;
+	}
+
+	// elements outside the clip (partial redraws) are skipped one by one, a child can still overhang its parent.
+	// elements in a layout transition are drawn at their visual offset (and their ancestors')
+	void RenderContent(RenderBackend& renderer, sf::RenderStates states) {
+		if (!OutsideClip(renderer, states, getDrawBounds())) {
+			DrawVisits++;
+			DrawSelf(renderer, states);
+		}
+
+		states.transform.translate(ChildTranslation());
+		bool offsets = childStore.HasOffsets();
+		for (std::size_t i = 0; i < childStore.Size(); ) {
+			std::uint8_t f = childStore.flags[i];
+			if (ElementStore::SkipsRender(f)) {
+				i = childStore.subtreeEnds[i];
+				continue;
+			}
+			UIElement* element = childStore.elements[i];
+			sf::RenderStates elementStates = states;
+			if (offsets) elementStates.transform.translate(childStore.VisualOffset(static_cast<std::int32_t>(i)));
+			if (f & ElementStore::Boundary) {
+				element->Render(renderer, elementStates);
+			} else if (!OutsideClip(renderer, elementStates, childStore.drawBounds[i])) {
+				DrawVisits++;
+				element->DrawSelf(renderer, elementStates);
+			}
+			i++;
 		}
-		if(onTick) onTick(*this);
 	}
 
-    void DrawSelf(sf::RenderTarget& target, sf::RenderStates states) override {
+public:
+
+    void DrawSelf(RenderBackend& renderer, sf::RenderStates states) override {
 		if(!visible) return;
-		//auto e_position = interpolated_position.getValue();	//testing interpolation
 
         // main background (root body)
-        sf::RectangleShape rect(e_size);
-        rect.setPosition(e_position);
-        rect.setFillColor(e_fillcolor);
-        rect.setOutlineColor(sf::Color::Black);
-        rect.setOutlineThickness(2.f);
-        target.draw(rect, states);
+        renderer.FillRect({e_position, e_size}, e_fillcolor, 2.f, sf::Color::Black, states);
 
         // header bar (slightly darker)
         if (headerHeight > 0.f) {
@@ -93,107 +211,41 @@ public:
             headerBarColor.r = static_cast<sf::Uint8>(headerBarColor.r * 0.7f);
             headerBarColor.g = static_cast<sf::Uint8>(headerBarColor.g * 0.7f);
             headerBarColor.b = static_cast<sf::Uint8>(headerBarColor.b * 0.7f);
-            sf::RectangleShape headerRect({e_size.x, headerHeight});
-            headerRect.setPosition(e_position.x, e_position.y - headerHeight);
-            headerRect.setFillColor(headerBarColor);
-            headerRect.setOutlineColor(sf::Color::Black);
-            headerRect.setOutlineThickness(2.f);
-            target.draw(headerRect, states);
-
-            sf::Text headerText;
+            renderer.FillRect({e_position.x, e_position.y - headerHeight, e_size.x, headerHeight}, headerBarColor, 2.f, sf::Color::Black, states);
+
             headerText.setString(headerTitle);
             headerText.setCharacterSize(24);
             headerText.setFillColor(sf::Color::White);
             headerText.setFont(font);
             headerText.setPosition(e_position.x + 10, (e_position.y - headerHeight) + (headerHeight - headerText.getLocalBounds().height) / 2.f - headerText.getLocalBounds().top);
-            target.draw(headerText, states);
+            renderer.DrawText(headerText, states);
         }
 		
 		if (layoutDirty) {
-			sf::ConvexShape triangle;
-			triangle.setPointCount(3);
-			triangle.setPoint(0, e_position);
-			triangle.setPoint(1, e_position + sf::Vector2f(10, 0));
-			triangle.setPoint(2, e_position + sf::Vector2f(0, 10));
-			triangle.setFillColor(sf::Color::Red);
-			target.draw(triangle, states);
+			renderer.FillTriangle(e_position, e_position + sf::Vector2f(10, 0), e_position + sf::Vector2f(0, 10), sf::Color::Red, states);
 		}
     }
 
-    void CalculateLayout() override {
-		if (!enabled) return;
+	sf::Vector2f ChildTranslation() const override { return e_position; }
+	ElementStore* ChildStore() override { return &childStore; }
 
-		if(!layoutDirty) return;
-		layoutDirty = false;
-
-		// position calculations
-		switch (layoutType) {
-			case LayoutType::Static:
-			case LayoutType::Anchor:
-				e_position = e_offset;
-				break;
-
-			case LayoutType::Relative:
-				if (auto parentPtr = parent.lock()) {
-					e_position = parentPtr->e_position + parentPtr->e_padding + e_offset;
-				} else {
-					e_position = e_offset;
-				}
-				break;
-
-			case LayoutType::Percent:
-				if (auto parentPtr = parent.lock()) {
-					sf::Vector2f parentSize = parentPtr->e_size - parentPtr->e_padding * 2.0f;
-					e_position.x = parentPtr->e_position.x + parentPtr->e_padding.x + (parentSize.x * (e_offset.x / 100.f));
-					e_position.y = parentPtr->e_position.y + parentPtr->e_padding.y + (parentSize.y * (e_offset.y / 100.f));
-				}
-				break;
-		}
+	// the header bar sits above the body and is part of the root
+	sf::FloatRect getHitBounds() const override {
+		return {e_position.x, e_position.y - headerHeight, e_size.x, e_size.y + headerHeight};
+	}
 
-        // size calculations
-		switch (sizeType) {
-			case SizeType::FitContent: {
-				sf::Vector2f maxSize(0, 0);
-				for (const auto& child : children) {
-					child->CalculateLayout();
-					sf::Vector2f childBR = child->e_position + child->e_size - e_position;
-					maxSize.x = std::max(maxSize.x, childBR.x);
-					maxSize.y = std::max(maxSize.y, childBR.y);
-				}
-				e_size = maxSize + e_padding * 2.f;
-				break;
-			}
-			case SizeType::FillParent: {
-				if (auto parentPtr = parent.lock()) {
-					e_size = parentPtr->e_size - parentPtr->e_padding / 0.5f - e_offset;
-				}
-				break;
-			}
-			case SizeType::Percent: {
-				if (auto parentPtr = parent.lock()) {
-					auto parentArea = parentPtr->e_size - parentPtr->e_padding / 0.5f;
-					e_size.x = parentArea.x * (e_size.x / 100.f);
-					e_size.y = parentArea.y * (e_size.y / 100.f);
-				}
-				break;
-			}
-			case SizeType::Absolute:
-				break;
+	UIElement* HitTest(const sf::Vector2f& point) override {
+		if (!enabled || !visible) return nullptr;
+		sf::Vector2f local = point - ChildTranslation();
+		std::int32_t slot = childStore.TopmostAt(local);
+		if (slot >= 0) {
+			// nested roots look inside themselves
+			if (UIElement* inner = childStore.elements[slot]->HitTest(local - childStore.VisualOffset(slot))) return inner;
 		}
+		return getHitBounds().contains(point) ? this : nullptr;
+	}
 
-        for (auto& child : children) {
-            child->CalculateLayout();
-        }
-    }
-
-    UIElement* AddChild(std::shared_ptr<UIElement> child) override {
-        children.push_back(child);
-        child->parent = shared_from_this();
-		markLayoutDirty();
-        return child.get();
-    }
-
-    void HandleEvent(const UIEvent& event) override {
+    void HandleSelfEvent(const UIEvent& event) override {
 		if (!enabled) return;
 
         // dragging by header (now above the root)
@@ -203,26 +255,38 @@ public:
                 if (headerRect.contains(event.mousePos)) {
                     dragging = true;
                     dragOffset = event.mousePos - e_position;
+					if (e_visualOffset != sf::Vector2f(0, 0)) {
+						// caught mid-transition, it's picked up where it's drawn
+						snapNextMove = true;
+						setOffset(e_offset + e_visualOffset);
+					}
                     return;
                 }
             } else if (event.type == UIEventType::MouseUp && event.mouseButton == 0) {
                 dragging = false;
             } else if (event.type == UIEventType::MouseMove && dragging) {
+				// the root follows the cursor, a layout transition would make it lag
+				snapNextMove = true;
                 setOffset(event.mousePos - dragOffset);
-				markChildrenDirty();
                 return;
             }
         }
-        for (auto& child : children) {
-            child->HandleEvent(event);
-        }
     }
 
 private:
     std::string headerTitle = "";
     sf::Color headerColor = sf::Color(60, 60, 60);
     float headerHeight = 30.f;
-    sf::Font font = AssetManager::get().getFont("fonts/arial.ttf");
+    TextRun headerText;
+    FontHandle font = AssetManager::get().getFontHandle("fonts/arial.ttf");
+
+    ElementStore childStore;	// pre-order layout/hit state of everything below, in root-local space
+
+    // --- Layer cache (setCached) ---
+    bool cached = false;
+    bool layerValid = false;
+    sf::Vector2u layerSize;
+    sf::Vector2f layerOffset;	// layer corner relative to e_position
 
     // --- Dragging state ---
     bool dragging = false;
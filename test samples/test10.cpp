@@ -0,0 +1,92 @@
+#include "UILibrary.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+// layout and hit-test benchmark on a wide and a deep tree whose widgets are scattered over the heap
+// (junk allocations between them), so walking the objects misses the cache on every node.
+// GUI::HitTest scans the root's pre-order ElementStore, the object walk is what it replaced
+static double Milliseconds(std::chrono::steady_clock::duration d) {
+	return std::chrono::duration<double, std::milli>(d).count();
+}
+
+static UIElement* WalkHit(UIElement* element, const sf::Vector2f& point) {
+	if (!element->enabled || !element->visible) return nullptr;
+	if (auto container = dynamic_cast<UIContainer*>(element)) {
+		sf::Vector2f local = point - container->ChildTranslation();
+		for (auto it = container->children.rbegin(); it != container->children.rend(); ++it) {
+			if (UIElement* hit = WalkHit(it->get(), local)) return hit;
+		}
+	}
+	return element->getHitBounds().contains(point) ? element : nullptr;
+}
+
+static void Run(const char* label, int depth, int width, int leaves) {
+	using Clock = std::chrono::steady_clock;
+	std::vector<std::unique_ptr<char[]>> junk;
+
+	GUI UI;
+	auto Menu1 = UI.CreateRoot();
+	Menu1->setOffset({0, 30})
+		   .setLayoutType(LayoutType::Static)
+		   .setSizeType(SizeType::FitContent);
+
+	// width chains of depth nested lists, leaves labels in each list
+	int elements = 1;
+	for (int w = 0; w < width; w++) {
+		std::shared_ptr<UIContainer> parent = Menu1;
+		for (int d = 0; d < depth; d++) {
+			auto list = UI.CreateList();
+			list->setPadding({2, 2}).setSizeType(SizeType::FitContent).setHeaderHeight(0.f);
+			parent->AddChild(list);
+			parent = list;
+			for (int i = 0; i < leaves; i++) {
+				auto leaf = UI.CreateLabel();
+				leaf->setSizeType(SizeType::Absolute).setSize({40, 10});
+				parent->AddChild(leaf);
+				junk.push_back(std::make_unique<char[]>(512));
+			}
+			elements += leaves + 1;
+		}
+	}
+	UI.Update(0.f);
+
+	// every child moves with the padding, the whole tree is re-arranged
+	const int layouts = 10;
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < layouts; i++) {
+		Menu1->setPadding({float(i % 2) * 5.f, 0.f});
+		UI.Update(0.f);
+	}
+	double layoutMs = Milliseconds(Clock::now() - start) / layouts;
+
+	sf::FloatRect area = Menu1->getHitBounds();
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> x(area.left, area.left + area.width);
+	std::uniform_real_distribution<float> y(area.top, area.top + area.height);
+	std::vector<sf::Vector2f> points(5000);
+	for (auto& point : points) point = {x(random), y(random)};
+
+	std::vector<UIElement*> storeHits(points.size()), walkHits(points.size());
+	start = Clock::now();
+	for (std::size_t i = 0; i < points.size(); i++) storeHits[i] = UI.HitTest(points[i]);
+	double storeMs = Milliseconds(Clock::now() - start);
+
+	start = Clock::now();
+	for (std::size_t i = 0; i < points.size(); i++) walkHits[i] = WalkHit(Menu1.get(), points[i] - Menu1->e_visualOffset);
+	double walkMs = Milliseconds(Clock::now() - start);
+
+	std::cout << label << " (" << elements << " elements): layout " << layoutMs << " ms, hit test "
+			  << storeMs * 1e6 / points.size() << " ns store / " << walkMs * 1e6 / points.size()
+			  << " ns object walk" << (storeHits == walkHits ? "" : ", results differ") << '\n';
+}
+
+int main() {
+	std::cout << std::fixed << std::setprecision(1);
+	Run("wide", 1, 100, 200);
+	Run("deep", 400, 1, 15);
+	return 0;
+}
@@ -0,0 +1,78 @@
+#include "UILibrary.hpp"
+#include "utils/EasingBatch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// easing table accuracy and speed: every built-in curve (and a registered cubic-bezier) sampled
+// across [0, 1] through EasingCurves::Sample and EasingBatch::Ease, compared with EaseExact.
+// prints the max error of each and exits with 1 if one is off by more than the tables promise
+// (1e-4, 3e-3 for bounce, whose corners fall between samples)
+static double Milliseconds(std::chrono::steady_clock::duration d) {
+	return std::chrono::duration<double, std::milli>(d).count();
+}
+
+int main() {
+	using Clock = std::chrono::steady_clock;
+	EasingCurves& curves = EasingCurves::get();
+
+	struct Named { InterpolationType type; const char* name; };
+	std::vector<Named> types = {
+		{InterpolationType::easeInOutElastic, "easeInOutElastic"},
+		{InterpolationType::easeInQuad, "easeInQuad"},
+		{InterpolationType::easeOutQuad, "easeOutQuad"},
+		{InterpolationType::easeInOutQuad, "easeInOutQuad"},
+		{InterpolationType::easeInCubic, "easeInCubic"},
+		{InterpolationType::easeOutCubic, "easeOutCubic"},
+		{InterpolationType::easeInOutCubic, "easeInOutCubic"},
+		{InterpolationType::easeInOutSine, "easeInOutSine"},
+		{InterpolationType::easeOutBack, "easeOutBack"},
+		{InterpolationType::easeOutBounce, "easeOutBounce"},
+		{InterpolationType::cssEase, "cssEase"},
+		{InterpolationType::cssEaseIn, "cssEaseIn"},
+		{InterpolationType::cssEaseOut, "cssEaseOut"},
+		{InterpolationType::cssEaseInOut, "cssEaseInOut"},
+		{curves.RegisterCubicBezier(0.68f, -0.55f, 0.27f, 1.55f), "cubic-bezier(.68,-.55,.27,1.55)"},
+	};
+
+	const std::size_t samples = 100001;
+	std::vector<float> t(samples), batch(samples);
+	for (std::size_t i = 0; i < samples; i++) t[i] = float(i) / float(samples - 1);
+
+	bool failed = false;
+	std::cout << std::scientific << std::setprecision(2);
+	for (const Named& curve : types) {
+		std::copy(t.begin(), t.end(), batch.begin());
+		EasingBatch::Ease(curve.type, batch.data(), samples);
+
+		float tableError = 0.f, batchError = 0.f;
+		for (std::size_t i = 0; i < samples; i++) {
+			float exact = curves.EaseExact(curve.type, t[i]);
+			tableError = std::max(tableError, std::fabs(curves.Sample(curve.type, t[i]) - exact));
+			batchError = std::max(batchError, std::fabs(batch[i] - exact));
+		}
+		float limit = curve.type == InterpolationType::easeOutBounce ? 3e-3f : 1e-4f;
+		bool ok = tableError <= limit && batchError <= limit;
+		failed = failed || !ok;
+		std::cout << std::setw(34) << std::left << curve.name << " table " << tableError << "  batch " << batchError
+				  << (ok ? "" : "  over the limit") << '\n';
+	}
+
+	// lookup against the analytic curve, for the slowest ones. the sums are printed so neither loop is dropped
+	std::cout << std::fixed << std::setprecision(1);
+	for (const Named& curve : {types[0], types.back()}) {
+		float sum = 0.f;
+		Clock::time_point start = Clock::now();
+		for (float v : t) sum += curves.Sample(curve.type, v);
+		double sampleNs = Milliseconds(Clock::now() - start) * 1e6 / samples;
+		start = Clock::now();
+		for (float v : t) sum += curves.EaseExact(curve.type, v);
+		double exactNs = Milliseconds(Clock::now() - start) * 1e6 / samples;
+		std::cout << curve.name << ": table " << sampleNs << " ns, exact " << exactNs << " ns per value (sum " << sum << ")\n";
+	}
+
+	return failed ? 1 : 0;
+}
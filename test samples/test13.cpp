@@ -0,0 +1,64 @@
+#include "UILibrary.hpp"
+#include "renderer/RecordingRenderBackend.hpp"
+#include <iostream>
+
+// damage coverage check, headless: partial redraws have to reach everything a widget draws outside its
+// hit area. a bound slider's value text (right of the track) and a list's header bar (above its body)
+// are changed, then the recorded frame must repaint them. exits with 1 if one was left stale
+static bool Covered(const DamageRegion& damage, const sf::FloatRect& box) {
+	for (const sf::FloatRect& rect : damage.Rects()) {
+		if (rect.left <= box.left && rect.top <= box.top &&
+			rect.left + rect.width >= box.left + box.width && rect.top + rect.height >= box.top + box.height) return true;
+	}
+	return false;
+}
+
+int main() {
+	GUI UI;
+	RecordingRenderBackend recorder;
+	const sf::FloatRect area(0, 0, 1200, 800);
+
+	auto Menu1 = UI.CreateRoot();
+	Menu1->setOffset({10, 40}).setSize({600, 400}).setLayoutType(LayoutType::Static).setHeaderHeight(0);
+
+	float volume = 1.f;
+	auto Slider1 = UI.CreateSlider();
+	Slider1->setOffset({20, 20}).setSize({200, 20}).setRange(0, 100000);
+	Slider1->setBoundValue(&volume);
+	Menu1->AddChild(Slider1);
+
+	auto List1 = UI.CreateList();
+	List1->setOffset({20, 150}).setSize({200, 100});
+	Menu1->AddChild(List1);
+
+	UI.Update(0.01f);
+	UI.drawDamaged(recorder, sf::Color::White, area);
+
+	bool failed = false;
+
+	// the bound value changes from outside, the new (wider) text must be inside the damage and drawn
+	volume = 99999.f;
+	UI.Update(0.01f);
+	UI.drawDamaged(recorder, sf::Color::White, area);
+	bool drawn = false;
+	for (const RenderCommand& command : recorder.GetCommands()) {
+		if (command.type != RenderCommandType::Text || recorder.GetText(command) != U"99999.00") continue;
+		sf::FloatRect ink = TextMeasureCache::get().Measure(*command.font, command.characterSize, "99999.00").bounds;
+		sf::FloatRect box(command.rect.left + ink.left, command.rect.top + ink.top, ink.width, ink.height);
+		drawn = Covered(UI.GetDamage(), box);
+	}
+	std::cout << "slider value text repainted: " << (drawn ? "yes" : "no") << '\n';
+	failed = failed || !drawn;
+
+	// the header bar sits above the list's position
+	List1->setHeaderColor(sf::Color::Red);
+	UI.Update(0.01f);
+	UI.drawDamaged(recorder, sf::Color::White, area);
+	sf::Vector2f listPosition = List1->getGlobalPosition();
+	sf::FloatRect header(listPosition.x, listPosition.y - 30.f, List1->e_size.x, 30.f);
+	bool headerDrawn = Covered(UI.GetDamage(), header);
+	std::cout << "list header repainted: " << (headerDrawn ? "yes" : "no") << '\n';
+	failed = failed || !headerDrawn;
+
+	return failed ? 1 : 0;
+}
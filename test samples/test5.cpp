@@ -0,0 +1,116 @@
+#include "UILibrary.hpp"
+#include "SFML/Graphics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// event-driven loop: no frame limit, the window only redraws when the GUI says something changed
+// and otherwise sleeps in waitEvent, so an idle window uses next to no CPU.
+// the GUI is kept in a layer that only gets its damaged areas repainted
+int main() {
+    sf::RenderWindow window(sf::VideoMode(1200, 800), "SFML gui - event driven");
+
+	float volume = 50.f;
+	int frames = 0;
+
+	GUI UI;
+
+	auto Menu1 = UI.CreateRoot();
+	Menu1->setOffset({400, 100})
+		   .setPadding({10, 15})
+		   .setSize({400, 400})
+		   .setFillColor({250,250,50,50})
+		   .setLayoutType(LayoutType::Static)
+		   .setSizeType(SizeType::FitContent)
+		   .setHeaderTitle("Idle Menu");
+
+	auto List1 = UI.CreateList();
+	List1->setPadding({10, 10})
+		   .setFillColor({250,100,50,50})
+		   .setSizeType(SizeType::FitContent)
+		   .setHeaderHeight(0.f)
+		   .setSpacing(15.f);
+
+	auto Button1 = UI.CreateButton();
+	Button1->setSize({200, 50})
+		   .setFillColor({150,250,50,200})
+		   .setLabel("hover me");
+
+	auto Slider1 = UI.CreateSlider();
+	Slider1->setSize({200, 30})
+		   .setRange(0.f, 100.f)
+		   .setBoundValue(&volume);
+
+	auto Label1 = UI.CreateLabel();
+	Label1->setBoundValue(&volume, "volume %.0f");
+
+	auto InputField = UI.CreateTextField();
+	InputField->setSizeType(SizeType::FitContent)
+				.setPlaceholder("click to type...")
+				.setPlaceholderColor(sf::Color(100, 100, 100));
+
+	List1->AddChild(Button1);
+	List1->AddChild(Slider1);
+	List1->AddChild(Label1);
+	List1->AddChild(InputField);
+	Menu1->AddChild(List1);
+
+	const sf::Color background(150, 150, 150);
+	sf::RenderTexture layer;
+	layer.create(window.getSize().x, window.getSize().y);
+	layer.clear(background);
+
+	sf::Clock clock;
+
+    while (window.isOpen()) {
+		sf::Event event;
+		float wait = UI.TimeUntilNextChange();
+
+		if (!UI.NeedsRedraw()) {
+			if (std::isinf(wait)) {
+				// nothing scheduled, block until the OS has input for us
+				if (window.waitEvent(event)) {
+					if (event.type == sf::Event::Closed) window.close();
+					UI.ProcessEvent(event);
+				}
+			} else if (wait > 0.f) {
+				// something is due later (caret blink), sleep until then unless input comes first
+				sf::Clock waited;
+				bool gotEvent = false;
+				while (!gotEvent && waited.getElapsedTime().asSeconds() < wait) {
+					while (window.pollEvent(event)) {
+						if (event.type == sf::Event::Closed) window.close();
+						UI.ProcessEvent(event);
+						gotEvent = true;
+					}
+					if (!gotEvent) sf::sleep(sf::milliseconds(static_cast<sf::Int32>(std::min(wait * 1000.f, 10.f))));
+				}
+			}
+		}
+
+		while (window.pollEvent(event)) {
+			if (event.type == sf::Event::Closed)
+				window.close();
+
+			UI.ProcessEvent(event);
+		}
+
+		float dt = clock.restart().asSeconds();
+		UI.Update(dt);
+
+		if (!UI.NeedsRedraw()) continue;
+
+		UI.drawDamaged(layer, background);
+		layer.display();
+
+        window.clear(background);
+        window.draw(sf::Sprite(layer.getTexture()));
+        window.display();
+
+		const FrameStats& stats = UI.GetFrameStats();
+		std::cout << "frame " << ++frames << ": " << stats.damageRects << " rects, "
+				  << stats.pixelsRedrawn << " px, " << stats.elementsDrawn << " elements\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "UILibrary.hpp"
+#include "SFML/Graphics.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// a virtualized list over 100k log lines: only the rows on screen exist, scroll with the mouse wheel
+int main() {
+    sf::RenderWindow window(sf::VideoMode(1200, 800), "SFML gui - virtualized list");
+	window.setFramerateLimit(100);
+
+	std::vector<std::string> log;
+	for (int i = 0; i < 100000; i++) log.push_back("[" + std::to_string(i) + "] entry " + std::to_string(i * 7919 % 100003));
+
+	GUI UI;
+
+	auto Menu1 = UI.CreateRoot();
+	Menu1->setOffset({300, 100})
+		   .setPadding({10, 15})
+		   .setSize({600, 600})
+		   .setFillColor({250,250,50,50})
+		   .setLayoutType(LayoutType::Static)
+		   .setSizeType(SizeType::Absolute)
+		   .setHeaderTitle("Log");
+
+	auto List1 = UI.CreateList();
+	List1->setSize({580, 570})
+		   .setPadding({5, 5})
+		   .setFillColor({250,100,50,50})
+		   .setSizeType(SizeType::Absolute)
+		   .setHeaderHeight(0.f)
+		   .setSpacing(2.f)
+		   .setRowHeight(24.f)
+		   .setDataSource(
+				[&log] { return log.size(); },
+				[&UI] {
+					auto row = UI.CreateLabel();
+					row->setSize({560, 24}).setTextSize(16);
+					return std::shared_ptr<UIElement>(row);
+				},
+				[&log](UIElement& row, std::size_t item) {
+					static_cast<UILabel&>(row).setText(log[item]);
+				});
+
+	Menu1->AddChild(List1);
+
+	sf::Clock clock;
+
+    while (window.isOpen()) {
+		sf::Event event;
+		while (window.pollEvent(event)) {
+			if (event.type == sf::Event::Closed)
+				window.close();
+
+			UI.ProcessEvent(event);
+		}
+
+		float dt = clock.restart().asSeconds();
+		UI.Update(dt);
+
+        window.clear(sf::Color(150, 150, 150));
+        UI.draw(window);
+        window.display();
+
+		const FrameStats& stats = UI.GetFrameStats();
+		std::cout << "rows " << List1->getRowCount() << " of " << List1->getItemCount()
+				  << ", elements drawn " << stats.elementsDrawn << "\r";
+    }
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "UILibrary.hpp"
+#include "renderer/GlyphAtlas.hpp"
+#include "SFML/Graphics.hpp"
+#include <iostream>
+#include <string>
+
+// glyph page memory check: fills a root with more and more widgets and draws a frame after each batch.
+// every widget holds the same FontHandle, so the glyph memory (the shared atlas plus arial's own pages)
+// has to stay where the first batch left it. exits with 1 if it grew
+static std::size_t GlyphBytes(const sf::Font& font) {
+	sf::Vector2u atlas = GlyphAtlas::get().GetSize();
+	std::size_t bytes = std::size_t(atlas.x) * atlas.y * 4;
+	for (unsigned int size = 8; size <= 48; size++) {
+		sf::Vector2u page = font.getTexture(size).getSize();
+		bytes += std::size_t(page.x) * page.y * 4;
+	}
+	return bytes;
+}
+
+int main() {
+	sf::RenderTexture target;
+	if (!target.create(1200, 800)) {
+		std::cout << "no render texture\n";
+		return 1;
+	}
+
+	GUI UI;
+	FontHandle arial = AssetManager::get().getFontHandle("fonts/arial.ttf");
+
+	auto Menu1 = UI.CreateRoot();
+	Menu1->setOffset({0, 30})
+		   .setSize({1200, 770})
+		   .setLayoutType(LayoutType::Static)
+		   .setSizeType(SizeType::Absolute)
+		   .setHeaderTitle("Glyph memory");
+
+	std::size_t firstBytes = 0;
+	bool grew = false;
+	int widgets = 0;
+	for (int batch : {250, 750, 3000, 6000}) {
+		for (; widgets < batch; widgets++) {
+			sf::Vector2f cell(float(widgets % 12) * 100.f, float(widgets / 12 % 40) * 19.f);
+			std::string text = "item " + std::to_string(widgets);
+			switch (widgets % 3) {
+				case 0: {
+					auto label = UI.CreateLabel();
+					label->setText(text).setTextSize(14).setSizeType(SizeType::Absolute).setSize({100, 19}).setOffset(cell);
+					Menu1->AddChild(label);
+					break;
+				}
+				case 1: {
+					auto button = UI.CreateButton();
+					button->setLabel(text).setTextSize(14).setSize({95, 18}).setOffset(cell);
+					Menu1->AddChild(button);
+					break;
+				}
+				default: {
+					auto field = UI.CreateTextField();
+					field->setString(text).setStringSize(14).setSizeType(SizeType::Absolute).setSize({95, 18}).setOffset(cell);
+					Menu1->AddChild(field);
+					break;
+				}
+			}
+		}
+
+		UI.Update(0.f);
+		target.clear(sf::Color(150, 150, 150));
+		UI.draw(target);
+		target.display();
+
+		std::size_t bytes = GlyphBytes(*arial);
+		if (firstBytes == 0) firstBytes = bytes;
+		grew = grew || bytes > firstBytes;
+		std::cout << widgets << " widgets: glyph memory " << bytes / 1024 << " KiB, atlas glyphs "
+				  << GlyphAtlas::get().GlyphCount() << ", font handle holders " << arial.use_count() - 1 << '\n';
+	}
+
+	std::cout << (grew ? "glyph memory grew with the widget count\n" : "glyph memory stayed flat\n");
+	return grew ? 1 : 0;
+}
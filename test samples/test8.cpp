@@ -0,0 +1,87 @@
+#include "UILibrary.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// name lookup benchmark on a 100k element tree: GUI::GetElementByName (one hash lookup in the
+// GUI's name index) against the recursive walk it replaced, then removing subtrees by name
+static std::shared_ptr<UIElement> FindRecursive(const std::shared_ptr<UIElement>& element, const std::string& name) {
+	if (element->id == name) return element;
+	if (auto container = std::dynamic_pointer_cast<UIContainer>(element)) {
+		for (const auto& child : container->children) {
+			if (auto found = FindRecursive(child, name)) return found;
+		}
+	}
+	return nullptr;
+}
+
+static double Milliseconds(std::chrono::steady_clock::duration d) {
+	return std::chrono::duration<double, std::milli>(d).count();
+}
+
+int main() {
+	using Clock = std::chrono::steady_clock;
+
+	GUI UI;
+	auto Menu1 = UI.CreateRoot();
+	Menu1->setLayoutType(LayoutType::Static);
+
+	// 100 sections of 10 groups of 100 labels
+	std::vector<std::string> names;
+	std::vector<std::string> groups;
+	for (int s = 0; s < 100; s++) {
+		auto section = UI.CreateList();
+		Menu1->AddChild(section);
+		for (int g = 0; g < 10; g++) {
+			auto group = UI.CreateList();
+			section->AddChild(group);
+			groups.push_back(group->id);
+			for (int i = 0; i < 100; i++) {
+				auto label = UI.CreateLabel();
+				group->AddChild(label);
+				names.push_back(label->id);
+			}
+		}
+	}
+	std::cout << "tree of " << names.size() + groups.size() + 100 << " elements\n";
+
+	std::mt19937 random(7);
+	std::uniform_int_distribution<std::size_t> pick(0, names.size() - 1);
+
+	const int walkLookups = 200;
+	Clock::time_point start = Clock::now();
+	std::size_t found = 0;
+	for (int i = 0; i < walkLookups; i++) {
+		for (const auto& root : UI.GetRoots()) {
+			if (FindRecursive(root, names[pick(random)])) {
+				found++;
+				break;
+			}
+		}
+	}
+	double walkMs = Milliseconds(Clock::now() - start);
+
+	const int indexLookups = 100000;
+	start = Clock::now();
+	for (int i = 0; i < indexLookups; i++) {
+		if (UI.GetElementByName(names[pick(random)])) found++;
+	}
+	double indexMs = Milliseconds(Clock::now() - start);
+
+	std::cout << std::fixed << std::setprecision(1)
+			  << "recursive walk: " << walkMs * 1e6 / walkLookups << " ns per lookup\n"
+			  << "name index:     " << indexMs * 1e6 / indexLookups << " ns per lookup\n"
+			  << "found " << found << " of " << walkLookups + indexLookups << '\n';
+
+	// each group takes its 100 labels with it
+	start = Clock::now();
+	for (int g = 0; g < 100; g++) UI.RemoveElementByName(groups[g * 10]);
+	double removeMs = Milliseconds(Clock::now() - start);
+	std::cout << "removed 100 groups (10100 elements) in " << removeMs << " ms, "
+			  << (UI.GetElementByName(groups[0]) ? "still indexed\n" : "gone from the index\n");
+
+	return 0;
+}
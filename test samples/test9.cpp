@@ -0,0 +1,44 @@
+#include "UILibrary.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// create/destroy throughput: a 50k widget screen built and torn down with one make_shared per
+// widget (AllocationMode::Shared) and out of the GUI's widget arena (AllocationMode::Pooled)
+static double Milliseconds(std::chrono::steady_clock::duration d) {
+	return std::chrono::duration<double, std::milli>(d).count();
+}
+
+static void Run(AllocationMode mode, const char* label) {
+	using Clock = std::chrono::steady_clock;
+	const int count = 50000;
+	const int rounds = 5;
+	double createMs = 0.0, destroyMs = 0.0;
+
+	GUI UI(mode);
+	for (int round = 0; round < rounds; round++) {
+		Clock::time_point start = Clock::now();
+		UIRoot* screen = UI.Get(UI.Create<UIRoot>());
+		for (int i = 0; i < count; i++) {
+			auto button = UI.Share(UI.Create<UIButton>());
+			button->setOffset({float(i % 100) * 10.f, float(i / 100) * 10.f});
+			screen->AddChild(button);
+		}
+		createMs += Milliseconds(Clock::now() - start);
+
+		start = Clock::now();
+		UI.DestroyAll();
+		destroyMs += Milliseconds(Clock::now() - start);
+	}
+
+	std::cout << label << ": create " << createMs / rounds << " ms, destroy " << destroyMs / rounds
+			  << " ms (" << count * 2.0 * rounds / (createMs + destroyMs) << " widgets/ms)\n";
+}
+
+int main() {
+	std::cout << std::fixed << std::setprecision(1);
+	Run(AllocationMode::Shared, "shared");
+	Run(AllocationMode::Pooled, "pooled");
+	return 0;
+}